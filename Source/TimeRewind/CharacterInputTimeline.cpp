@@ -0,0 +1,335 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "CharacterInputTimeline.h"
+
+//bits of the header byte written at the start of every frame
+enum ECharacterInputFlags : uint8
+{
+	DeltaTimeChanged = 1 << 0,
+	InputChanged = 1 << 1,
+	RotationChanged = 1 << 2,
+	RequestedVelocityChanged = 1 << 3,
+	HasRequestedVelocity = 1 << 4,
+	WantsJump = 1 << 5,
+	Fired = 1 << 6
+};
+
+//seconds in each step of a stored delta time
+static constexpr float DeltaTimePrecision = 0.0001f;
+
+//Round a frame length to the steps stored in the stream
+static uint16 QuantizeDeltaTime(float deltaTime)
+{
+	return uint16(FMath::Clamp(FMath::RoundToInt(deltaTime / DeltaTimePrecision), 0, int32(MAX_uint16)));
+}
+
+//Round a movement input axis, which is between -1 and 1, to the steps stored in the stream
+static int8 QuantizeInputAxis(double value)
+{
+	return int8(FMath::Clamp(FMath::RoundToInt(value * 127.0), -127, 127));
+}
+
+//Round a requested velocity axis to whole units per second
+static int16 QuantizeVelocityAxis(double value)
+{
+	return int16(FMath::Clamp(FMath::RoundToInt(value), -int32(MAX_int16), int32(MAX_int16)));
+}
+
+//Append a 16 bit value to the stream
+static void WriteUInt16(TArray<uint8>& stream, uint16 value)
+{
+	stream.Add(uint8(value & 0xFF));
+	stream.Add(uint8(value >> 8));
+}
+
+//Read a 16 bit value from the stream
+static uint16 ReadUInt16(const TArray<uint8>& stream, int32& inOutIndex)
+{
+	uint16 value = uint16(stream[inOutIndex]) | uint16(stream[inOutIndex + 1]) << 8;
+	inOutIndex += 2;
+
+	return value;
+}
+
+//Round every value to the precision stored in the input stream
+void FCharacterInputFrame::Quantize()
+{
+	deltaTime = QuantizeDeltaTime(deltaTime) * DeltaTimePrecision;
+
+	inputVector = FVector(QuantizeInputAxis(inputVector.X), QuantizeInputAxis(inputVector.Y), QuantizeInputAxis(inputVector.Z)) / 127.0;
+
+	//roll is never driven by look input
+	controlRotation = FRotator(FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(controlRotation.Pitch)),
+		FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(controlRotation.Yaw)), 0.0);
+
+	requestedVelocity = hasRequestedVelocity
+		? FVector(QuantizeVelocityAxis(requestedVelocity.X), QuantizeVelocityAxis(requestedVelocity.Y), QuantizeVelocityAxis(requestedVelocity.Z))
+		: FVector::ZeroVector;
+}
+
+//Set the number of recorded ticks between checkpoints and drop anything recorded
+void FCharacterInputTimeline::Init(int32 newCheckpointTicks)
+{
+	checkpointTicks = FMath::Max(newCheckpointTicks, 1);
+	Reset();
+}
+
+//Drop everything recorded
+void FCharacterInputTimeline::Reset()
+{
+	stream.Reset();
+	streamStartOffset = 0;
+	tickOffsets.Reset();
+	firstTick = INDEX_NONE;
+	checkpoints.Reset();
+	lastFrame = FCharacterInputFrame();
+	forceCheckpoint = true;
+}
+
+//Append one frame of input, encoded as the difference from the previous frame
+void FCharacterInputTimeline::RecordFrame(const FCharacterInputFrame& frame)
+{
+	//frames before the first checkpoint have nothing to be replayed from
+	if (checkpoints.Num() == 0)
+	{
+		return;
+	}
+
+	//compare what would be stored, so values that only change below the stored precision are not written
+	FCharacterInputFrame storedFrame = frame;
+	storedFrame.Quantize();
+
+	uint8 flags = 0;
+	flags |= storedFrame.deltaTime != lastFrame.deltaTime ? DeltaTimeChanged : 0;
+	flags |= storedFrame.inputVector != lastFrame.inputVector ? InputChanged : 0;
+	flags |= storedFrame.controlRotation != lastFrame.controlRotation ? RotationChanged : 0;
+	flags |= storedFrame.requestedVelocity != lastFrame.requestedVelocity ? RequestedVelocityChanged : 0;
+	flags |= storedFrame.hasRequestedVelocity ? HasRequestedVelocity : 0;
+	flags |= storedFrame.wantsJump ? WantsJump : 0;
+	flags |= storedFrame.fired ? Fired : 0;
+
+	stream.Add(flags);
+
+	if (flags & DeltaTimeChanged)
+	{
+		WriteUInt16(stream, QuantizeDeltaTime(storedFrame.deltaTime));
+	}
+
+	if (flags & InputChanged)
+	{
+		stream.Add(uint8(QuantizeInputAxis(storedFrame.inputVector.X)));
+		stream.Add(uint8(QuantizeInputAxis(storedFrame.inputVector.Y)));
+		stream.Add(uint8(QuantizeInputAxis(storedFrame.inputVector.Z)));
+	}
+
+	if (flags & RotationChanged)
+	{
+		WriteUInt16(stream, FRotator::CompressAxisToShort(storedFrame.controlRotation.Pitch));
+		WriteUInt16(stream, FRotator::CompressAxisToShort(storedFrame.controlRotation.Yaw));
+	}
+
+	if (flags & RequestedVelocityChanged)
+	{
+		WriteUInt16(stream, uint16(QuantizeVelocityAxis(storedFrame.requestedVelocity.X)));
+		WriteUInt16(stream, uint16(QuantizeVelocityAxis(storedFrame.requestedVelocity.Y)));
+		WriteUInt16(stream, uint16(QuantizeVelocityAxis(storedFrame.requestedVelocity.Z)));
+	}
+
+	lastFrame = storedFrame;
+}
+
+//Check if marking an absolute tick has to store a checkpoint
+bool FCharacterInputTimeline::NeedsCheckpoint(int64 tick) const
+{
+	//a gap in the marked ticks starts the stream again from a checkpoint
+	bool isNextTick = firstTick != INDEX_NONE && tick == firstTick + tickOffsets.Num();
+
+	return forceCheckpoint || !isNextTick || tick % checkpointTicks == 0;
+}
+
+//Mark the start of an absolute recording tick, storing the checkpoint if one is given
+void FCharacterInputTimeline::MarkTick(int64 tick, const FCharacterCheckpoint* checkpoint)
+{
+	//a gap cannot be replayed across, and a new stream cannot start without a checkpoint
+	if (firstTick == INDEX_NONE || tick != firstTick + tickOffsets.Num())
+	{
+		Reset();
+
+		if (checkpoint == nullptr)
+		{
+			return;
+		}
+
+		firstTick = tick;
+	}
+
+	tickOffsets.Add(GetStreamEnd());
+
+	if (checkpoint != nullptr)
+	{
+		FCharacterCheckpoint& newCheckpoint = checkpoints.Add_GetRef(*checkpoint);
+		newCheckpoint.tick = tick;
+		newCheckpoint.byteOffset = GetStreamEnd();
+
+		//frames after a checkpoint are encoded from a default frame so they can be decoded from it
+		lastFrame = FCharacterInputFrame();
+		forceCheckpoint = false;
+	}
+}
+
+//Drop everything not needed to rebuild an absolute tick or anything after it
+void FCharacterInputTimeline::PruneBefore(int64 tick)
+{
+	//keep the last checkpoint at or before the tick, it is where rebuilding the tick starts
+	int32 keepIndex = 0;
+
+	while (keepIndex + 1 < checkpoints.Num() && checkpoints[keepIndex + 1].tick <= tick)
+	{
+		keepIndex++;
+	}
+
+	if (keepIndex == 0)
+	{
+		return;
+	}
+
+	const FCharacterCheckpoint& keptCheckpoint = checkpoints[keepIndex];
+
+	//the stream is only trimmed once per checkpoint, so the cost of moving it is spread over many ticks
+	stream.RemoveAt(0, int32(keptCheckpoint.byteOffset - streamStartOffset), false);
+	streamStartOffset = keptCheckpoint.byteOffset;
+
+	tickOffsets.RemoveAt(0, int32(keptCheckpoint.tick - firstTick), false);
+	firstTick = keptCheckpoint.tick;
+
+	checkpoints.RemoveAt(0, keepIndex, false);
+}
+
+//Drop everything recorded from an absolute tick on, such as an abandoned future after resuming
+void FCharacterInputTimeline::TruncateFrom(int64 tick)
+{
+	int64 tickOffset = GetTickOffset(tick);
+
+	//nothing recorded from the tick on
+	if (tickOffset == INDEX_NONE)
+	{
+		//resuming before anything was recorded starts the stream again
+		if (firstTick == INDEX_NONE || tick < firstTick)
+		{
+			Reset();
+		}
+
+		return;
+	}
+
+	stream.SetNum(int32(tickOffset - streamStartOffset), false);
+	tickOffsets.SetNum(int32(tick - firstTick), false);
+
+	checkpoints.RemoveAll([tick](const FCharacterCheckpoint& checkpoint)
+	{
+		return checkpoint.tick >= tick;
+	});
+
+	//frames recorded before the tick is marked again are encoded from a default frame,
+	//so the tick always starts from a checkpoint of where the character actually resumed
+	lastFrame = FCharacterInputFrame();
+	forceCheckpoint = true;
+
+	if (checkpoints.Num() == 0)
+	{
+		Reset();
+	}
+}
+
+//Find the checkpoint to rebuild an absolute tick from
+const FCharacterCheckpoint* FCharacterInputTimeline::FindCheckpoint(int64 tick) const
+{
+	if (GetTickOffset(tick) == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	for (int32 checkpointIndex = checkpoints.Num() - 1; checkpointIndex >= 0; checkpointIndex--)
+	{
+		if (checkpoints[checkpointIndex].tick <= tick)
+		{
+			return &checkpoints[checkpointIndex];
+		}
+	}
+
+	return nullptr;
+}
+
+//Get the absolute offset into the input stream where an absolute tick starts
+int64 FCharacterInputTimeline::GetTickOffset(int64 tick) const
+{
+	if (firstTick == INDEX_NONE || tick < firstTick || tick >= firstTick + tickOffsets.Num())
+	{
+		return INDEX_NONE;
+	}
+
+	return tickOffsets[int32(tick - firstTick)];
+}
+
+//Decode the frame at an absolute offset over the frame before it, returning the offset of the next frame
+int64 FCharacterInputTimeline::ReadFrame(int64 byteOffset, FCharacterInputFrame& inOutFrame) const
+{
+	int32 streamIndex = int32(byteOffset - streamStartOffset);
+
+	if (!stream.IsValidIndex(streamIndex))
+	{
+		return GetStreamEnd();
+	}
+
+	uint8 flags = stream[streamIndex++];
+
+	if (flags & DeltaTimeChanged)
+	{
+		inOutFrame.deltaTime = ReadUInt16(stream, streamIndex) * DeltaTimePrecision;
+	}
+
+	if (flags & InputChanged)
+	{
+		inOutFrame.inputVector.X = int8(stream[streamIndex++]) / 127.0;
+		inOutFrame.inputVector.Y = int8(stream[streamIndex++]) / 127.0;
+		inOutFrame.inputVector.Z = int8(stream[streamIndex++]) / 127.0;
+	}
+
+	if (flags & RotationChanged)
+	{
+		inOutFrame.controlRotation.Pitch = FRotator::DecompressAxisFromShort(ReadUInt16(stream, streamIndex));
+		inOutFrame.controlRotation.Yaw = FRotator::DecompressAxisFromShort(ReadUInt16(stream, streamIndex));
+	}
+
+	if (flags & RequestedVelocityChanged)
+	{
+		inOutFrame.requestedVelocity.X = int16(ReadUInt16(stream, streamIndex));
+		inOutFrame.requestedVelocity.Y = int16(ReadUInt16(stream, streamIndex));
+		inOutFrame.requestedVelocity.Z = int16(ReadUInt16(stream, streamIndex));
+	}
+
+	inOutFrame.hasRequestedVelocity = (flags & HasRequestedVelocity) != 0;
+	inOutFrame.wantsJump = (flags & WantsJump) != 0;
+	inOutFrame.fired = (flags & Fired) != 0;
+
+	return streamStartOffset + streamIndex;
+}
+
+//Get the bytes held by the input stream and checkpoints
+int64 FCharacterInputTimeline::GetAllocatedBytes() const
+{
+	return stream.GetAllocatedSize() + tickOffsets.GetAllocatedSize() + checkpoints.GetAllocatedSize();
+}
+
+//Get the absolute offset of the end of the stream
+int64 FCharacterInputTimeline::GetStreamEnd() const
+{
+	return streamStartOffset + stream.Num();
+}
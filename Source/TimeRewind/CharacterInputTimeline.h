@@ -0,0 +1,129 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Everything a character movement component consumed during one frame
+ */
+struct TIMEREWIND_API FCharacterInputFrame
+{
+	//length of the frame in seconds
+	float deltaTime = 0.0f;
+
+	//world space movement input from Move, already turned by the control rotation
+	FVector inputVector = FVector::ZeroVector;
+
+	//rotation the controller was looking in after Look was applied
+	FRotator controlRotation = FRotator::ZeroRotator;
+
+	//velocity asked for by path following, such as AI moving to a goal
+	FVector requestedVelocity = FVector::ZeroVector;
+	bool hasRequestedVelocity = false;
+
+	//was jump held this frame
+	bool wantsJump = false;
+
+	//did the character fire this frame
+	bool fired = false;
+
+	//Round every value to the precision stored in the input stream
+	void Quantize();
+};
+
+/**
+ * Movement state of a character at the start of a recorded tick, the point input streams are replayed from
+ */
+struct TIMEREWIND_API FCharacterCheckpoint
+{
+	//absolute tick the checkpoint was taken at
+	int64 tick = INDEX_NONE;
+
+	//absolute offset into the input stream of the first frame after the checkpoint
+	int64 byteOffset = 0;
+
+	FVector location = FVector::ZeroVector;
+	FRotator rotation = FRotator::ZeroRotator;
+	FRotator controlRotation = FRotator::ZeroRotator;
+	FVector velocity = FVector::ZeroVector;
+
+	//EMovementMode and custom movement mode of the character movement component
+	uint8 movementMode = 0;
+	uint8 customMovementMode = 0;
+};
+
+/**
+ * Input stream of one character with periodic movement checkpoints.
+ * Each frame is written as the difference from the frame before it, so a character standing still costs
+ * a couple of bytes per frame instead of a transform per tick. Every few ticks the encoder starts again from
+ * a checkpoint, so a tick is rebuilt by restoring the checkpoint before it and replaying the frames in between.
+ */
+class TIMEREWIND_API FCharacterInputTimeline
+{
+public:
+	//Set the number of recorded ticks between checkpoints and drop anything recorded
+	void Init(int32 newCheckpointTicks);
+
+	//Drop everything recorded
+	void Reset();
+
+	//Append one frame of input, encoded as the difference from the previous frame
+	void RecordFrame(const FCharacterInputFrame& frame);
+
+	//Check if marking an absolute tick has to store a checkpoint
+	bool NeedsCheckpoint(int64 tick) const;
+
+	//Mark the start of an absolute recording tick, storing the checkpoint if one is given
+	//Ticks must be marked in order, a gap starts the stream again
+	void MarkTick(int64 tick, const FCharacterCheckpoint* checkpoint);
+
+	//Drop everything not needed to rebuild an absolute tick or anything after it
+	void PruneBefore(int64 tick);
+
+	//Drop everything recorded from an absolute tick on, such as an abandoned future after resuming
+	void TruncateFrom(int64 tick);
+
+	//Find the checkpoint to rebuild an absolute tick from. Returns nullptr if the tick was not recorded
+	const FCharacterCheckpoint* FindCheckpoint(int64 tick) const;
+
+	//Get the absolute offset into the input stream where an absolute tick starts. Returns INDEX_NONE if the tick was not recorded
+	int64 GetTickOffset(int64 tick) const;
+
+	//Decode the frame at an absolute offset over the frame before it, returning the offset of the next frame
+	//Decoding from a checkpoint starts from a default frame
+	int64 ReadFrame(int64 byteOffset, FCharacterInputFrame& inOutFrame) const;
+
+	//Get the bytes held by the input stream and checkpoints
+	int64 GetAllocatedBytes() const;
+
+private:
+	//encoded frames, the first byte is at absolute offset streamStartOffset
+	TArray<uint8> stream;
+	int64 streamStartOffset = 0;
+
+	//absolute offset into the stream where each marked tick starts, the first is for firstTick
+	TArray<int64> tickOffsets;
+	int64 firstTick = INDEX_NONE;
+
+	//checkpoints oldest first
+	TArray<FCharacterCheckpoint> checkpoints;
+
+	//last frame written, the encoder's baseline for the next one
+	FCharacterInputFrame lastFrame;
+
+	//number of recorded ticks between checkpoints
+	int32 checkpointTicks = 16;
+
+	//should the next marked tick store a checkpoint whatever its number
+	bool forceCheckpoint = true;
+
+	//Get the absolute offset of the end of the stream
+	int64 GetStreamEnd() const;
+};
@@ -0,0 +1,382 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "GeometryCollectionTimeline.h"
+#include "GeometryCollection/GeometryCollection.h"
+#include "GeometryCollection/GeometryCollectionObject.h"
+#include "Algo/BinarySearch.h"
+
+//Set up the timeline for a geometry collection, keying every piece's starting state at a tick
+void FGeometryCollectionTimeline::Init(UGeometryCollectionComponent* newGeometryCollection, int64 tick)
+{
+	geometryCollection = newGeometryCollection;
+	firstRecordedTick = tick;
+	breakKeys.Reset();
+	pieceKeys.Reset();
+
+	const FGeometryDynamicCollection* dynamicCollection = newGeometryCollection->GetDynamicCollection();
+
+	if (dynamicCollection == nullptr)
+	{
+		return;
+	}
+
+	pieceKeys.SetNum(dynamicCollection->Transform.Num());
+
+	for (int32 pieceIndex = 0; pieceIndex < pieceKeys.Num(); pieceIndex++)
+	{
+		AddKey(pieceIndex, tick, dynamicCollection->Transform[pieceIndex], dynamicCollection->Parent[pieceIndex]);
+	}
+}
+
+//Key every piece that moved or changed parent since its last key
+void FGeometryCollectionTimeline::Capture(int64 tick, float positionTolerance, float rotationTolerance)
+{
+	UGeometryCollectionComponent* collection = geometryCollection.Get();
+	const FGeometryDynamicCollection* dynamicCollection = collection != nullptr ? collection->GetDynamicCollection() : nullptr;
+
+	//skip if the collection was destroyed or its pieces changed since registration
+	if (dynamicCollection == nullptr || dynamicCollection->Transform.Num() != pieceKeys.Num())
+	{
+		return;
+	}
+
+	const float positionToleranceSquared = FMath::Square(positionTolerance);
+
+	for (int32 pieceIndex = 0; pieceIndex < pieceKeys.Num(); pieceIndex++)
+	{
+		//pieces still attached to an unbroken cluster are not moving on their own
+		if (!dynamicCollection->Active[pieceIndex])
+		{
+			continue;
+		}
+
+		const FTransform& pieceTransform = dynamicCollection->Transform[pieceIndex];
+		int32 parent = dynamicCollection->Parent[pieceIndex];
+		const FGeometryPieceKey& lastKey = pieceKeys[pieceIndex].Last();
+
+		//only key pieces that moved or changed parent since their last key
+		bool hasMoved = FVector3f::DistSquared(lastKey.position, FVector3f(pieceTransform.GetLocation())) > positionToleranceSquared
+			|| lastKey.rotation.Dequantize().AngularDistance(FQuat4f(pieceTransform.GetRotation())) > rotationTolerance;
+
+		if (hasMoved || lastKey.parent != parent)
+		{
+			AddKey(pieceIndex, tick, pieceTransform, parent);
+		}
+	}
+}
+
+//Log a break reported by Chaos
+void FGeometryCollectionTimeline::RecordBreak(int64 tick, int32 pieceIndex, const FVector& location)
+{
+	FGeometryBreakKey newBreak;
+	newBreak.tick = tick;
+	newBreak.pieceIndex = pieceIndex;
+	newBreak.location = FVector3f(location);
+
+	breakKeys.Add(newBreak);
+}
+
+//Write the pieces' recorded state at a playback time in ticks, blending between keys
+void FGeometryCollectionTimeline::Apply(double playbackTime)
+{
+	UGeometryCollectionComponent* collection = geometryCollection.Get();
+	FGeometryDynamicCollection* dynamicCollection = collection != nullptr ? collection->GetDynamicCollection() : nullptr;
+
+	if (dynamicCollection == nullptr || dynamicCollection->Transform.Num() != pieceKeys.Num())
+	{
+		return;
+	}
+
+	for (int32 pieceIndex = 0; pieceIndex < pieceKeys.Num(); pieceIndex++)
+	{
+		const TArray<FGeometryPieceKey>& keys = pieceKeys[pieceIndex];
+
+		//find the last key at or before the playback time
+		int32 keyIndex = Algo::UpperBoundBy(keys, int64(FMath::FloorToDouble(playbackTime)), &FGeometryPieceKey::tick) - 1;
+		keyIndex = FMath::Max(keyIndex, 0);
+
+		const FGeometryPieceKey& fromKey = keys[keyIndex];
+		FVector3f position = fromKey.position;
+		FQuat4f rotation = fromKey.rotation.Dequantize();
+
+		//blend towards the next key if the piece was moving
+		if (keys.IsValidIndex(keyIndex + 1) && keys[keyIndex + 1].parent == fromKey.parent)
+		{
+			const FGeometryPieceKey& toKey = keys[keyIndex + 1];
+			float alpha = float(FMath::Clamp((playbackTime - fromKey.tick) / double(toKey.tick - fromKey.tick), 0.0, 1.0));
+
+			position = FMath::Lerp(position, toKey.position, alpha);
+			rotation = FQuat4f::Slerp(rotation, toKey.rotation.Dequantize(), alpha);
+		}
+
+		dynamicCollection->Transform[pieceIndex] = FTransform(FQuat(rotation), FVector(position), dynamicCollection->Transform[pieceIndex].GetScale3D());
+		dynamicCollection->Parent[pieceIndex] = fromKey.parent;
+	}
+
+	//one render update for every piece written
+	collection->MarkRenderDynamicDataDirty();
+	collection->MarkRenderTransformDirty();
+}
+
+//Switch the collection between simulating and being posed by the timeline
+void FGeometryCollectionTimeline::SetPlaybackMode(bool enablePlayback, int64 resumeTick)
+{
+	UGeometryCollectionComponent* collection = geometryCollection.Get();
+
+	if (collection == nullptr || enablePlayback == isInPlayback)
+	{
+		return;
+	}
+
+	isInPlayback = enablePlayback;
+
+	if (enablePlayback)
+	{
+		wasSimulating = collection->IsSimulatingPhysics();
+		collection->SetSimulatePhysics(false);
+		return;
+	}
+
+	//collections nothing happened to after the resume tick are still in that state, physics included, so only changed ones are rebuilt
+	if (HasChangedSince(resumeTick))
+	{
+		//the physics proxy keeps its own particles, so the resume pose is handed to it as the collection's rest state
+		//and the physics state is rebuilt from it instead of only writing the game thread transforms
+		TArray<FTransform> restTransforms;
+
+		if (BuildRestTransforms(resumeTick, restTransforms))
+		{
+			collection->SetRestState(MoveTemp(restTransforms));
+		}
+
+		//Chaos cannot rejoin broken pieces, so the rebuilt collection is unbroken
+		//and every piece that was broken at the resume tick is broken off again
+		collection->RecreatePhysicsState();
+
+		TArray<FGeometryBreakKey> resumeBreaks;
+		FindBreaksAt(resumeTick, resumeBreaks);
+
+		for (const FGeometryBreakKey& breakKey : resumeBreaks)
+		{
+			collection->ApplyExternalStrain(FGeometryCollectionItemIndex::CreateTransformItemIndex(breakKey.pieceIndex), FVector(breakKey.location), 0.0f, 0, 1.0f, TNumericLimits<float>::Max());
+		}
+	}
+
+	collection->SetSimulatePhysics(wasSimulating);
+
+	//keep the game thread pose in step until the first physics results arrive
+	Apply(double(resumeTick));
+}
+
+//Check if any piece moved, broke or changed parent at or after a tick
+bool FGeometryCollectionTimeline::HasChangedSince(int64 tick) const
+{
+	//breaks and parent changes are keyed like moves, so the newest key of each piece is enough
+	for (const TArray<FGeometryPieceKey>& keys : pieceKeys)
+	{
+		if (keys.Num() > 0 && keys.Last().tick >= tick)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//Find every piece broken off its parent in the unbroken collection at a tick, in the order they broke
+void FGeometryCollectionTimeline::FindBreaksAt(int64 tick, TArray<FGeometryBreakKey>& outBreaks) const
+{
+	outBreaks.Reset();
+
+	UGeometryCollectionComponent* collection = geometryCollection.Get();
+	const UGeometryCollection* restCollection = collection != nullptr ? collection->GetRestCollection() : nullptr;
+
+	if (restCollection == nullptr || !restCollection->GetGeometryCollection().IsValid())
+	{
+		return;
+	}
+
+	const TManagedArray<int32>& restParents = restCollection->GetGeometryCollection()->Parent;
+
+	if (restParents.Num() != pieceKeys.Num())
+	{
+		return;
+	}
+
+	//logged breaks know where they happened, breaks from before the window only have the piece's recorded position
+	TMap<int32, FVector3f> breakLocations;
+
+	for (const FGeometryBreakKey& breakKey : breakKeys)
+	{
+		if (breakKey.tick < tick)
+		{
+			breakLocations.Add(breakKey.pieceIndex, breakKey.location);
+		}
+	}
+
+	TArray<int32> restDepths;
+	restDepths.SetNumZeroed(pieceKeys.Num());
+	const FTransform& componentTransform = collection->GetComponentTransform();
+
+	for (int32 pieceIndex = 0; pieceIndex < pieceKeys.Num(); pieceIndex++)
+	{
+		const TArray<FGeometryPieceKey>& keys = pieceKeys[pieceIndex];
+		int32 keyIndex = FMath::Max(Algo::UpperBoundBy(keys, tick, &FGeometryPieceKey::tick) - 1, 0);
+
+		//only pieces with a parent in the unbroken collection and none at the tick were broken off
+		if (restParents[pieceIndex] == INDEX_NONE || keys[keyIndex].parent != INDEX_NONE)
+		{
+			continue;
+		}
+
+		//the piece broke at the first of the keys without a parent leading up to the tick
+		int32 breakIndex = keyIndex;
+
+		while (breakIndex > 0 && keys[breakIndex - 1].parent == INDEX_NONE)
+		{
+			breakIndex--;
+		}
+
+		//clusters are broken before the pieces inside them when they broke on the same tick
+		int32 depth = 0;
+
+		for (int32 parent = restParents[pieceIndex]; parent >= 0 && parent < restParents.Num() && depth < restParents.Num(); parent = restParents[parent])
+		{
+			depth++;
+		}
+
+		restDepths[pieceIndex] = depth;
+
+		//broken pieces are keyed relative to the component
+		const FVector3f* breakLocation = breakLocations.Find(pieceIndex);
+
+		FGeometryBreakKey& newBreak = outBreaks.AddDefaulted_GetRef();
+		newBreak.tick = keys[breakIndex].tick;
+		newBreak.pieceIndex = pieceIndex;
+		newBreak.location = breakLocation != nullptr ? *breakLocation : FVector3f(componentTransform.TransformPosition(FVector(keys[breakIndex].position)));
+	}
+
+	outBreaks.Sort([&restDepths](const FGeometryBreakKey& first, const FGeometryBreakKey& second)
+	{
+		return first.tick != second.tick ? first.tick < second.tick : restDepths[first.pieceIndex] < restDepths[second.pieceIndex];
+	});
+}
+
+//Build every piece's transform at a tick relative to its parent in the unbroken collection
+bool FGeometryCollectionTimeline::BuildRestTransforms(int64 tick, TArray<FTransform>& outTransforms) const
+{
+	UGeometryCollectionComponent* collection = geometryCollection.Get();
+	const UGeometryCollection* restCollection = collection != nullptr ? collection->GetRestCollection() : nullptr;
+
+	if (restCollection == nullptr || !restCollection->GetGeometryCollection().IsValid())
+	{
+		return false;
+	}
+
+	const TManagedArray<int32>& restParents = restCollection->GetGeometryCollection()->Parent;
+
+	if (restParents.Num() != pieceKeys.Num())
+	{
+		return false;
+	}
+
+	//recorded transforms are relative to the parent each piece had at the time, broken pieces to the component
+	TArray<FTransform> componentTransforms;
+	TArray<bool> isResolved;
+	componentTransforms.SetNum(pieceKeys.Num());
+	isResolved.SetNumZeroed(pieceKeys.Num());
+
+	//resolve a piece's component transform through its recorded parents
+	TFunction<const FTransform&(int32)> resolvePiece = [&](int32 pieceIndex) -> const FTransform&
+	{
+		if (!isResolved[pieceIndex])
+		{
+			const TArray<FGeometryPieceKey>& keys = pieceKeys[pieceIndex];
+			int32 keyIndex = FMath::Max(Algo::UpperBoundBy(keys, tick, &FGeometryPieceKey::tick) - 1, 0);
+			const FGeometryPieceKey& key = keys[keyIndex];
+
+			//mark first so a corrupt parent loop ends instead of recursing forever
+			isResolved[pieceIndex] = true;
+			componentTransforms[pieceIndex] = FTransform(FQuat(key.rotation.Dequantize()), FVector(key.position));
+
+			if (pieceKeys.IsValidIndex(key.parent))
+			{
+				componentTransforms[pieceIndex] *= resolvePiece(key.parent);
+			}
+		}
+
+		return componentTransforms[pieceIndex];
+	};
+
+	outTransforms.SetNum(pieceKeys.Num());
+
+	for (int32 pieceIndex = 0; pieceIndex < pieceKeys.Num(); pieceIndex++)
+	{
+		const FTransform& pieceTransform = resolvePiece(pieceIndex);
+		int32 restParent = restParents[pieceIndex];
+
+		outTransforms[pieceIndex] = restParent != INDEX_NONE ? pieceTransform.GetRelativeTransform(resolvePiece(restParent)) : pieceTransform;
+	}
+
+	return true;
+}
+
+//Drop keys and breaks from a tick onwards
+void FGeometryCollectionTimeline::TruncateFrom(int64 tick)
+{
+	for (TArray<FGeometryPieceKey>& keys : pieceKeys)
+	{
+		//always keep the first key so every piece has a state
+		while (keys.Num() > 1 && keys.Last().tick >= tick)
+		{
+			keys.Pop(false);
+		}
+	}
+
+	while (breakKeys.Num() > 0 && breakKeys.Last().tick >= tick)
+	{
+		breakKeys.Pop(false);
+	}
+}
+
+//Drop keys and breaks no longer needed to know each piece's state at the start of the window
+void FGeometryCollectionTimeline::PruneBefore(int64 tick)
+{
+	for (TArray<FGeometryPieceKey>& keys : pieceKeys)
+	{
+		//keep the last key at or before the tick as the piece's starting state
+		int32 numExpired = Algo::UpperBoundBy(keys, tick, &FGeometryPieceKey::tick) - 1;
+
+		if (numExpired > 0)
+		{
+			keys.RemoveAt(0, numExpired, false);
+		}
+	}
+
+	//pieces broken before the window keep a key without a parent, which is all resuming needs to break them off again
+	int32 numExpiredBreaks = Algo::LowerBoundBy(breakKeys, tick, &FGeometryBreakKey::tick);
+
+	if (numExpiredBreaks > 0)
+	{
+		breakKeys.RemoveAt(0, numExpiredBreaks, false);
+	}
+}
+
+//Add a key for a piece from the collection's current state
+void FGeometryCollectionTimeline::AddKey(int32 pieceIndex, int64 tick, const FTransform& pieceTransform, int32 parent)
+{
+	FGeometryPieceKey newKey;
+	newKey.tick = tick;
+	newKey.position = FVector3f(pieceTransform.GetLocation());
+	newKey.rotation = FQuantizedRotation::Quantize(FQuat4f(pieceTransform.GetRotation()));
+	newKey.parent = parent;
+
+	pieceKeys[pieceIndex].Add(newKey);
+}
@@ -0,0 +1,106 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GeometryCollection/GeometryCollectionComponent.h"
+#include "TimelineQuantization.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * Recorded transform and parent of one geometry collection piece from a tick onwards
+ */
+struct TIMEREWIND_API FGeometryPieceKey
+{
+	//absolute recording tick the piece reached this state
+	int64 tick = 0;
+	//transform of the piece relative to its parent
+	FVector3f position = FVector3f::ZeroVector;
+	FQuantizedRotation rotation;
+	//parent piece, INDEX_NONE once the piece broke free
+	int32 parent = INDEX_NONE;
+};
+
+/**
+ * Break logged for a geometry collection piece
+ */
+struct TIMEREWIND_API FGeometryBreakKey
+{
+	//absolute recording tick of the break
+	int64 tick = 0;
+	//transform index of the piece that broke off
+	int32 pieceIndex = INDEX_NONE;
+	//world location of the break
+	FVector3f location = FVector3f::ZeroVector;
+};
+
+/**
+ * Timeline for a Chaos geometry collection's fracture state.
+ * Recording is incremental: a piece only gets a new key when it moved or changed parent since its last key
+ * and breaks are logged as events, so resting and unbroken pieces cost nothing per tick.
+ * Keys are addressed by absolute recording tick so they do not shift with the recorded window.
+ */
+class TIMEREWIND_API FGeometryCollectionTimeline
+{
+public:
+	//weak reference to the recorded geometry collection so destroyed collections are detected instead of dereferenced
+	TWeakObjectPtr<UGeometryCollectionComponent> geometryCollection;
+
+	//absolute recording tick of the first position this timeline recorded
+	int64 firstRecordedTick = 0;
+
+	//Set up the timeline for a geometry collection, keying every piece's starting state at a tick
+	void Init(UGeometryCollectionComponent* newGeometryCollection, int64 tick);
+
+	//Key every piece that moved or changed parent since its last key
+	void Capture(int64 tick, float positionTolerance, float rotationTolerance);
+
+	//Log a break reported by Chaos
+	void RecordBreak(int64 tick, int32 pieceIndex, const FVector& location);
+
+	//Write the pieces' recorded state at a playback time in ticks, blending between keys
+	void Apply(double playbackTime);
+
+	//Switch the collection between simulating and being posed by the timeline, restoring whether it simulated on resume
+	//Collections that changed after the resume tick have their physics state rebuilt at the recorded pose,
+	//restoring the unbroken collection and breaking off again every piece that was broken at that tick
+	void SetPlaybackMode(bool enablePlayback, int64 resumeTick);
+
+	//Drop keys and breaks from a tick onwards, such as an abandoned future
+	void TruncateFrom(int64 tick);
+
+	//Drop keys and breaks no longer needed to know each piece's state at the start of the window
+	void PruneBefore(int64 tick);
+
+private:
+	//keys of each piece in tick order, indexed by transform index
+	TArray<TArray<FGeometryPieceKey>> pieceKeys;
+
+	//breaks in the recorded window in tick order
+	TArray<FGeometryBreakKey> breakKeys;
+
+	//is the collection being posed by the timeline
+	bool isInPlayback = false;
+
+	//was the collection simulating when playback started
+	bool wasSimulating = false;
+
+	//Add a key for a piece from the collection's current state
+	void AddKey(int32 pieceIndex, int64 tick, const FTransform& pieceTransform, int32 parent);
+
+	//Check if any piece moved, broke or changed parent at or after a tick
+	bool HasChangedSince(int64 tick) const;
+
+	//Find every piece broken off its parent in the unbroken collection at a tick, in the order they broke
+	void FindBreaksAt(int64 tick, TArray<FGeometryBreakKey>& outBreaks) const;
+
+	//Build every piece's transform at a tick relative to its parent in the unbroken collection
+	//Returns false if the collection's rest hierarchy no longer matches the recorded pieces
+	bool BuildRestTransforms(int64 tick, TArray<FTransform>& outTransforms) const;
+};
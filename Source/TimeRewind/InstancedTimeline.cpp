@@ -0,0 +1,118 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "InstancedTimeline.h"
+
+//Set up the timeline for a mesh and the number of positions to record
+void FInstancedTimeline::Init(UInstancedStaticMeshComponent* newInstancedMesh, int numPositions)
+{
+	instancedMesh = newInstancedMesh;
+	numTimelinePositions = FMath::Max(numPositions, 0);
+	numInstances = newInstancedMesh->PerInstanceSMData.Num();
+	firstTick = 0;
+	recordedStaticMesh = newInstancedMesh->GetStaticMesh();
+	areInstancesChanged = false;
+
+	instancePositions.SetNumZeroed(numTimelinePositions * numInstances);
+	instanceRotations.SetNum(numTimelinePositions * numInstances);
+	instanceScales.SetNumUninitialized(numInstances);
+
+	//keep the scale of each instance once
+	for (int32 instanceIndex = 0; instanceIndex < numInstances; instanceIndex++)
+	{
+		instanceScales[instanceIndex] = FVector3f(FTransform(newInstancedMesh->PerInstanceSMData[instanceIndex].Transform).GetScale3D());
+	}
+}
+
+//Number of instances recorded at each position
+int32 FInstancedTimeline::NumInstances() const
+{
+	return numInstances;
+}
+
+//Check if the mesh still has the instances this timeline was set up for
+bool FInstancedTimeline::MatchesMesh() const
+{
+	UInstancedStaticMeshComponent* mesh = instancedMesh.Get();
+
+	//instances swapped at the same count keep the count, so changes are also reported by the mesh
+	return mesh != nullptr && !areInstancesChanged && mesh->PerInstanceSMData.Num() == numInstances && mesh->GetStaticMesh() == recordedStaticMesh.Get();
+}
+
+//Note that the mesh's instances were added, removed or moved to other indices
+void FInstancedTimeline::MarkInstancesChanged()
+{
+	areInstancesChanged = true;
+}
+
+//Record every instance at a timeline index in one pass over the instance data
+void FInstancedTimeline::Capture(int timelineIndex)
+{
+	if (!MatchesMesh() || timelineIndex < 0 || timelineIndex >= numTimelinePositions)
+	{
+		return;
+	}
+
+	//read instance data directly instead of through per instance getters
+	const TArray<FInstancedStaticMeshInstanceData>& instanceData = instancedMesh->PerInstanceSMData;
+	int32 firstInstance = GetFirstInstance(timelineIndex);
+
+	for (int32 instanceIndex = 0; instanceIndex < numInstances; instanceIndex++)
+	{
+		const FMatrix& instanceMatrix = instanceData[instanceIndex].Transform;
+
+		instancePositions[firstInstance + instanceIndex] = FVector3f(instanceMatrix.GetOrigin());
+		instanceRotations[firstInstance + instanceIndex] = FQuantizedRotation::Quantize(FQuat4f(instanceMatrix.ToQuat()));
+	}
+}
+
+//Move every instance between two timeline indices with one batch update and one render state update
+void FInstancedTimeline::Apply(int fromIndex, int toIndex, float alpha)
+{
+	if (!MatchesMesh() || toIndex < 0 || toIndex >= numTimelinePositions || numInstances == 0)
+	{
+		return;
+	}
+
+	fromIndex = FMath::Clamp(fromIndex, 0, numTimelinePositions - 1);
+
+	int32 firstFrom = GetFirstInstance(fromIndex);
+	int32 firstTo = GetFirstInstance(toIndex);
+
+	playbackTransforms.SetNumUninitialized(numInstances);
+
+	for (int32 instanceIndex = 0; instanceIndex < numInstances; instanceIndex++)
+	{
+		FVector3f position = FMath::Lerp(instancePositions[firstFrom + instanceIndex], instancePositions[firstTo + instanceIndex], alpha);
+		FQuat4f rotation = FQuat4f::Slerp(instanceRotations[firstFrom + instanceIndex].Dequantize(), instanceRotations[firstTo + instanceIndex].Dequantize(), alpha);
+
+		playbackTransforms[instanceIndex] = FTransform(FQuat(rotation), FVector(position), FVector(instanceScales[instanceIndex]));
+	}
+
+	//teleport so instances with physics bodies do not pick up velocity from the move
+	instancedMesh->BatchUpdateInstancesTransforms(0, playbackTransforms, false, true, true);
+}
+
+//Remove the oldest position and add a new one to the end
+void FInstancedTimeline::Shift()
+{
+	if (numTimelinePositions == 0)
+	{
+		return;
+	}
+
+	//moving the first tick forward drops the oldest position, whose place in the ring is written by the next capture
+	firstTick++;
+}
+
+//Get the index of the first instance stored for a timeline index
+int32 FInstancedTimeline::GetFirstInstance(int timelineIndex) const
+{
+	return int32((firstTick + timelineIndex) % numTimelinePositions) * numInstances;
+}
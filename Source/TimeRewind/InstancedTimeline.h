@@ -0,0 +1,81 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "TimelineQuantization.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * Timeline for every instance of an instanced or hierarchical instanced static mesh, such as debris.
+ * Instances are stored as structure of arrays with one entry per instance per timeline position,
+ * in component space with a quantized rotation, so an instance costs 20 bytes per position.
+ * Positions are a ring addressed by tick, so shifting the window moves no instance data.
+ * Instance scale is kept once from when the mesh was added since debris does not change size.
+ */
+class TIMEREWIND_API FInstancedTimeline
+{
+public:
+	//weak reference to the recorded mesh so destroyed meshes are detected instead of dereferenced
+	TWeakObjectPtr<UInstancedStaticMeshComponent> instancedMesh;
+
+	//absolute recording tick of the first position this timeline recorded
+	int64 firstRecordedTick = 0;
+
+	//Set up the timeline for a mesh and the number of positions to record
+	void Init(UInstancedStaticMeshComponent* newInstancedMesh, int numPositions);
+
+	//Number of instances recorded at each position
+	int32 NumInstances() const;
+
+	//Check if the mesh still has the instances this timeline was set up for, with the same static mesh and no instance added, removed or moved to another index
+	bool MatchesMesh() const;
+
+	//Note that the mesh's instances were added, removed or moved to other indices, so recorded positions no longer belong to the same instances
+	void MarkInstancesChanged();
+
+	//Record every instance at a timeline index in one pass over the instance data
+	void Capture(int timelineIndex);
+
+	//Move every instance between two timeline indices with one batch update and one render state update
+	void Apply(int fromIndex, int toIndex, float alpha);
+
+	//Remove the oldest position and add a new one to the end
+	void Shift();
+
+private:
+	//number of positions in the timeline
+	int numTimelinePositions = 0;
+
+	//number of instances recorded at each position
+	int32 numInstances = 0;
+
+	//tick of timeline index 0, increased by one each shift
+	int64 firstTick = 0;
+
+	//static mesh the instances were recorded with
+	TWeakObjectPtr<UStaticMesh> recordedStaticMesh;
+
+	//were instances added, removed or moved to other indices since the timeline was set up
+	bool areInstancesChanged = false;
+
+	//component space instance transforms at each position in a ring addressed by tick, numInstances entries per position
+	TArray<FVector3f> instancePositions;
+	TArray<FQuantizedRotation> instanceRotations;
+
+	//scale of each instance
+	TArray<FVector3f> instanceScales;
+
+	//instance transforms reused by every apply so playback does not allocate
+	TArray<FTransform> playbackTransforms;
+
+	//Get the index of the first instance stored for a timeline index
+	int32 GetFirstInstance(int timelineIndex) const;
+};
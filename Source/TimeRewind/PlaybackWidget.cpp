@@ -8,6 +8,8 @@
 
 
 #include "PlaybackWidget.h"
+#include "TimeRewindManager.h"
+#include "Kismet/GameplayStatics.h"
 
 void UPlaybackWidget::Construct()
 {
@@ -18,4 +20,60 @@ void UPlaybackWidget::Construct()
 void UPlaybackWidget::UpdatePaused(bool shouldPause)
 {
 	//component used by PlaybackUI blueprint
-}
\ No newline at end of file
+}
+
+//Bind to the time rewind manager's activity events
+void UPlaybackWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	rewindManager = Cast<ATimeRewindManager>(UGameplayStatics::GetActorOfClass(GetWorld(), ATimeRewindManager::StaticClass()));
+
+	if (rewindManager.IsValid())
+	{
+		rewindManager->OnTimelineActivityChanged.AddDynamic(this, &UPlaybackWidget::HandleActivityChanged);
+		rewindManager->OnTimelineActivityRefreshed.AddDynamic(this, &UPlaybackWidget::HandleActivityRefreshed);
+
+		//read the summary once, after this only changes are pushed
+		HandleActivityRefreshed();
+	}
+}
+
+//Unbind from the time rewind manager's activity events
+void UPlaybackWidget::NativeDestruct()
+{
+	if (rewindManager.IsValid())
+	{
+		rewindManager->OnTimelineActivityChanged.RemoveDynamic(this, &UPlaybackWidget::HandleActivityChanged);
+		rewindManager->OnTimelineActivityRefreshed.RemoveDynamic(this, &UPlaybackWidget::HandleActivityRefreshed);
+	}
+
+	rewindManager.Reset();
+
+	Super::NativeDestruct();
+}
+
+//Handle a single activity bucket change from the manager
+void UPlaybackWidget::HandleActivityChanged(int32 bucketIndex, const FTimelineActivityBucket& bucket)
+{
+	if (!activityBuckets.IsValidIndex(bucketIndex))
+	{
+		return;
+	}
+
+	activityBuckets[bucketIndex] = bucket;
+	OnActivityBucketChanged(bucketIndex, bucket);
+}
+
+//Handle a full activity refresh from the manager
+void UPlaybackWidget::HandleActivityRefreshed()
+{
+	if (!rewindManager.IsValid())
+	{
+		return;
+	}
+
+	activityBuckets = rewindManager->GetTimelineActivity();
+	activityBucketDuration = rewindManager->GetTimelineActivityBucketDuration();
+	OnActivityRefreshed();
+}
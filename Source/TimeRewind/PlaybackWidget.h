@@ -10,6 +10,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "TimelineActivityBucket.h"
 #include "PlaybackWidget.generated.h"
 
 /**
@@ -27,4 +28,43 @@ public:
 	//component used by PlaybackUI blueprint
 	UFUNCTION(BlueprintCallable, Category = "Playback")
 	void UpdatePaused(bool shouldPause);
+
+	//Activity summary for the scrub bar in playback order, kept up to date by the time rewind manager
+	//Exposed to blueprint for use in PlaybackUI blueprint
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Playback")
+	TArray<FTimelineActivityBucket> activityBuckets;
+
+	//Duration in seconds of each activity bucket
+	//Exposed to blueprint for use in PlaybackUI blueprint
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Playback")
+	float activityBucketDuration = 0.0f;
+
+	//Called after one activity bucket changed so only that part of the scrub bar is redrawn
+	//Implemented in PlaybackUI blueprint
+	UFUNCTION(BlueprintImplementableEvent, Category = "Playback")
+	void OnActivityBucketChanged(int32 bucketIndex, const FTimelineActivityBucket& bucket);
+
+	//Called after the whole activity summary changed and the scrub bar should be redrawn
+	//Implemented in PlaybackUI blueprint
+	UFUNCTION(BlueprintImplementableEvent, Category = "Playback")
+	void OnActivityRefreshed();
+
+protected:
+	//Bind to the time rewind manager's activity events
+	virtual void NativeConstruct() override;
+
+	//Unbind from the time rewind manager's activity events
+	virtual void NativeDestruct() override;
+
+private:
+	//manager the widget listens to
+	TWeakObjectPtr<class ATimeRewindManager> rewindManager;
+
+	//Handle a single activity bucket change from the manager
+	UFUNCTION()
+	void HandleActivityChanged(int32 bucketIndex, const FTimelineActivityBucket& bucket);
+
+	//Handle a full activity refresh from the manager
+	UFUNCTION()
+	void HandleActivityRefreshed();
 };
@@ -0,0 +1,190 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "SkeletalTimeline.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "Physics/PhysicsInterfaceCore.h"
+
+//Set up the timeline for a skeletal mesh and the number of positions to record
+void FSkeletalTimeline::Init(USkeletalMeshComponent* newSkeletalMesh, int numPositions)
+{
+	skeletalMesh = newSkeletalMesh;
+	numTimelinePositions = FMath::Max(numPositions, 0);
+
+	//the root body anchors every other body, fall back to the first body if the root bone has none
+	rootBodyIndex = FMath::Max(newSkeletalMesh->Bodies.IndexOfByKey(newSkeletalMesh->GetBodyInstance()), 0);
+
+	int32 numBodies = NumBodies();
+
+	rootPositions.SetNumZeroed(numTimelinePositions);
+	rootRotations.Init(FQuat4f::Identity, numTimelinePositions);
+	bodyRotations.SetNum(numTimelinePositions * numBodies);
+	bodyOffsets.SetNumZeroed(numTimelinePositions * numBodies);
+}
+
+//Number of bodies recorded at each position
+int32 FSkeletalTimeline::NumBodies() const
+{
+	USkeletalMeshComponent* mesh = skeletalMesh.Get();
+	return mesh != nullptr ? mesh->Bodies.Num() : 0;
+}
+
+//Record every body at a timeline index in one pass under a single physics read lock
+void FSkeletalTimeline::Capture(int timelineIndex)
+{
+	USkeletalMeshComponent* mesh = skeletalMesh.Get();
+
+	//skip if the mesh was destroyed, the index is out of range or the physics asset changed since registration
+	if (mesh == nullptr || timelineIndex < 0 || timelineIndex >= numTimelinePositions || mesh->Bodies.Num() * numTimelinePositions != bodyRotations.Num())
+	{
+		return;
+	}
+
+	FPhysicsCommand::ExecuteRead(mesh, [&]()
+	{
+		int32 numBodies = mesh->Bodies.Num();
+		FTransform rootTransform = mesh->Bodies[rootBodyIndex]->GetUnrealWorldTransform_AssumesLocked();
+		FTransform inverseRoot = rootTransform.Inverse();
+
+		rootPositions[timelineIndex] = FVector3f(rootTransform.GetLocation());
+		rootRotations[timelineIndex] = FQuat4f(rootTransform.GetRotation());
+
+		//store every body in the root body's space
+		int32 firstBody = timelineIndex * numBodies;
+
+		for (int32 bodyIndex = 0; bodyIndex < numBodies; bodyIndex++)
+		{
+			FTransform localTransform = mesh->Bodies[bodyIndex]->GetUnrealWorldTransform_AssumesLocked() * inverseRoot;
+			FVector3f localOffset = FVector3f(localTransform.GetLocation());
+
+			bodyRotations[firstBody + bodyIndex] = FQuantizedRotation::Quantize(FQuat4f(localTransform.GetRotation()));
+			bodyOffsets[firstBody + bodyIndex].x = FFloat16(localOffset.X);
+			bodyOffsets[firstBody + bodyIndex].y = FFloat16(localOffset.Y);
+			bodyOffsets[firstBody + bodyIndex].z = FFloat16(localOffset.Z);
+		}
+	});
+}
+
+//Pose every body between two timeline indices in one pass
+void FSkeletalTimeline::Apply(int fromIndex, int toIndex, float alpha)
+{
+	USkeletalMeshComponent* mesh = skeletalMesh.Get();
+
+	if (mesh == nullptr || toIndex < 0 || toIndex >= numTimelinePositions || mesh->Bodies.Num() * numTimelinePositions != bodyRotations.Num())
+	{
+		return;
+	}
+
+	fromIndex = FMath::Clamp(fromIndex, 0, numTimelinePositions - 1);
+
+	//decode both positions once, then blend and write every body
+	ReadBodyTransforms(fromIndex, fromTransforms);
+	ReadBodyTransforms(toIndex, toTransforms);
+
+	for (int32 bodyIndex = 0; bodyIndex < toTransforms.Num(); bodyIndex++)
+	{
+		FTransform blendedTransform;
+		blendedTransform.Blend(fromTransforms[bodyIndex], toTransforms[bodyIndex], alpha);
+
+		mesh->Bodies[bodyIndex]->SetBodyTransform(blendedTransform, ETeleportType::TeleportPhysics);
+	}
+}
+
+//Remove the oldest position and add a new one to the end
+void FSkeletalTimeline::Shift()
+{
+	if (numTimelinePositions == 0)
+	{
+		return;
+	}
+
+	int32 numBodies = bodyRotations.Num() / numTimelinePositions;
+
+	//slide every array down by one position, keeping the allocation
+	rootPositions.RemoveAt(0, 1, false);
+	rootPositions.AddZeroed();
+	rootRotations.RemoveAt(0, 1, false);
+	rootRotations.Add(FQuat4f::Identity);
+	bodyRotations.RemoveAt(0, numBodies, false);
+	bodyRotations.AddDefaulted(numBodies);
+	bodyOffsets.RemoveAt(0, numBodies, false);
+	bodyOffsets.AddZeroed(numBodies);
+}
+
+//Switch the bodies between simulating and being posed by the timeline
+void FSkeletalTimeline::SetPlaybackMode(bool enablePlayback)
+{
+	USkeletalMeshComponent* mesh = skeletalMesh.Get();
+
+	if (mesh == nullptr)
+	{
+		return;
+	}
+
+	if (enablePlayback)
+	{
+		//remember which bodies simulated so resuming restores exactly those, such as a partial ragdoll
+		savedSimulateStates.SetNum(mesh->Bodies.Num());
+
+		for (int32 bodyIndex = 0; bodyIndex < mesh->Bodies.Num(); bodyIndex++)
+		{
+			savedSimulateStates[bodyIndex] = mesh->Bodies[bodyIndex] != nullptr && mesh->Bodies[bodyIndex]->IsInstanceSimulatingPhysics();
+		}
+
+		//keep the pose following the bodies while animation stops moving them
+		savedKinematicUpdate = mesh->KinematicBonesUpdateType;
+		savedBlendPhysics = mesh->bBlendPhysics;
+		mesh->KinematicBonesUpdateType = EKinematicBonesUpdateToPhysics::SkipAllBones;
+		mesh->bBlendPhysics = true;
+		mesh->SetAllBodiesSimulatePhysics(false);
+	}
+	else
+	{
+		mesh->KinematicBonesUpdateType = savedKinematicUpdate;
+		mesh->bBlendPhysics = savedBlendPhysics;
+
+		//skip if the physics asset changed during playback, the saved states no longer match its bodies
+		if (savedSimulateStates.Num() != mesh->Bodies.Num())
+		{
+			return;
+		}
+
+		for (int32 bodyIndex = 0; bodyIndex < mesh->Bodies.Num(); bodyIndex++)
+		{
+			FBodyInstance* bodyInstance = mesh->Bodies[bodyIndex];
+
+			if (bodyInstance == nullptr || !savedSimulateStates[bodyIndex])
+			{
+				continue;
+			}
+
+			bodyInstance->SetInstanceSimulatePhysics(true);
+			bodyInstance->WakeInstance();
+		}
+	}
+}
+
+//Get the world transform of every body at a timeline index
+void FSkeletalTimeline::ReadBodyTransforms(int timelineIndex, TArray<FTransform>& outTransforms) const
+{
+	int32 numBodies = bodyRotations.Num() / numTimelinePositions;
+	int32 firstBody = timelineIndex * numBodies;
+
+	FTransform rootTransform = FTransform(FQuat(rootRotations[timelineIndex]), FVector(rootPositions[timelineIndex]));
+
+	outTransforms.SetNumUninitialized(numBodies);
+
+	for (int32 bodyIndex = 0; bodyIndex < numBodies; bodyIndex++)
+	{
+		const FQuantizedOffset& offset = bodyOffsets[firstBody + bodyIndex];
+		FTransform localTransform = FTransform(FQuat(bodyRotations[firstBody + bodyIndex].Dequantize()), FVector(offset.x.GetFloat(), offset.y.GetFloat(), offset.z.GetFloat()));
+
+		outTransforms[bodyIndex] = localTransform * rootTransform;
+	}
+}
@@ -0,0 +1,79 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "TimelineQuantization.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * Timeline for every simulated body of a skeletal mesh physics asset, such as a ragdoll.
+ * Bodies are stored as structure of arrays with one entry per body per timeline position.
+ * The root body keeps its full world transform, every other body keeps a quantized rotation and a half float offset
+ * in the root body's space, so a body costs 14 bytes per position instead of a full rewind struct.
+ */
+class TIMEREWIND_API FSkeletalTimeline
+{
+public:
+	//weak reference to the recorded skeletal mesh so destroyed meshes are detected instead of dereferenced
+	TWeakObjectPtr<USkeletalMeshComponent> skeletalMesh;
+
+	//absolute recording tick of the first position this timeline recorded
+	int64 firstRecordedTick = 0;
+
+	//Set up the timeline for a skeletal mesh and the number of positions to record
+	void Init(USkeletalMeshComponent* newSkeletalMesh, int numPositions);
+
+	//Number of bodies recorded at each position
+	int32 NumBodies() const;
+
+	//Record every body at a timeline index in one pass under a single physics read lock
+	void Capture(int timelineIndex);
+
+	//Pose every body between two timeline indices in one pass
+	void Apply(int fromIndex, int toIndex, float alpha);
+
+	//Remove the oldest position and add a new one to the end
+	void Shift();
+
+	//Switch the bodies between simulating and being posed by the timeline
+	void SetPlaybackMode(bool enablePlayback);
+
+private:
+	//number of positions in the timeline
+	int numTimelinePositions = 0;
+
+	//index of the root body in the mesh's body instances
+	int32 rootBodyIndex = 0;
+
+	//root body world transform at each position
+	TArray<FVector3f> rootPositions;
+	TArray<FQuat4f> rootRotations;
+
+	//every other body relative to the root at each position, numBodies entries per position
+	TArray<FQuantizedRotation> bodyRotations;
+	TArray<FQuantizedOffset> bodyOffsets;
+
+	//decoded body transforms reused by every apply so playback does not allocate
+	TArray<FTransform> fromTransforms;
+	TArray<FTransform> toTransforms;
+
+	//kinematic update setting to restore when playback ends
+	EKinematicBonesUpdateToPhysics::Type savedKinematicUpdate = EKinematicBonesUpdateToPhysics::SkipSimulatingBones;
+
+	//physics blending setting to restore when playback ends
+	bool savedBlendPhysics = false;
+
+	//whether each body simulated when playback started, restored when playback ends
+	TArray<bool> savedSimulateStates;
+
+	//Get the world transform of every body at a timeline index
+	void ReadBodyTransforms(int timelineIndex, TArray<FTransform>& outTransforms) const;
+};
@@ -3,5 +3,7 @@
 #include "TimeRewind.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogTimeRewind);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, TimeRewind, "TimeRewind" );
  
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "TimeRewindCharacter.h"
 #include "TimeRewindProjectile.h"
+#include "TimelineMovementComponent.h"
 #include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
@@ -12,7 +13,8 @@
 //////////////////////////////////////////////////////////////////////////
 // ATimeRewindCharacter
 
-ATimeRewindCharacter::ATimeRewindCharacter()
+ATimeRewindCharacter::ATimeRewindCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UTimelineMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
 	// Character doesnt have a rifle at start
 	//this is based on the default FPS template, but is not used
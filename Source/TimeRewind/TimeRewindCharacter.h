@@ -51,8 +51,8 @@ class ATimeRewindCharacter : public ACharacter
 
 	
 public:
-	//constructor
-	ATimeRewindCharacter();
+	//constructor, moves with a timeline movement component so its input can be recorded and replayed
+	ATimeRewindCharacter(const FObjectInitializer& ObjectInitializer);
 	//Setup player buttons and actions
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -11,8 +11,8 @@
 #include "GameFramework/Pawn.h"
 #include "Kismet/GameplayStatics.h"
 #include "TimeRewindCharacter.h"
+#include "TimelineMovementComponent.h"
 #include "PhysicsTimeActor.h"
-#include "TimeArrayStruct.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 
 
@@ -45,7 +45,11 @@ void ATimeRewindController::BeginPlay()
 	SetViewTarget(timeRewindCharacter);
 
 	//Find fire key to fire projectile function
-	InputComponent->BindAction(FName("Fire"), IE_Pressed, this, &ATimeRewindController::FireProjectile);
+	//controllers of remote players on the server have no input
+	if (InputComponent != nullptr)
+	{
+		InputComponent->BindAction(FName("Fire"), IE_Pressed, this, &ATimeRewindController::FireProjectile);
+	}
 
 	//if projectile and world objects defined, spawn default projectiles
 	if (ProjectileClass != nullptr && World != nullptr)
@@ -69,11 +73,16 @@ void ATimeRewindController::BeginPlay()
 			//Add to pre-spawned projectile list
 			projectileList.Add(newProjectile);
 
-			//if rewind manager exists, add collision object to tracked object list
+			//if rewind manager exists, add collision object to tracked object list and keep its timeline handle
+			//projectiles simulate once fired, so they are recorded with the simulating layout even though physics is off here
+			FTimelineHandle projectileHandle;
+
 			if (timeRewindManager != nullptr)
 			{
-				timeRewindManager->AppendPhysicsObject(boxCollision);
+				projectileHandle = timeRewindManager->AppendPhysicsObjectWithLayout(boxCollision, timeRewindManager->GetSimulatingTimelineLayout());
 			}
+
+			projectileHandleList.Add(projectileHandle);
 		}
 	}
 }
@@ -87,6 +96,18 @@ void ATimeRewindController::FireProjectile()
 		return;
 	}
 
+	//cannot fire without a character to fire from
+	if (timeRewindCharacter == nullptr)
+	{
+		return;
+	}
+
+	//the shot is part of the character's recorded input
+	if (UTimelineMovementComponent* characterMovement = Cast<UTimelineMovementComponent>(timeRewindCharacter->GetCharacterMovement()))
+	{
+		characterMovement->RecordFire();
+	}
+
 	//Find player rotation
 	const FRotator SpawnRotation = PlayerCameraManager->GetCameraRotation();
 	// MuzzleOffset is in camera space, so transform it to world space before offsetting from the character location to find the final muzzle position
@@ -98,8 +119,9 @@ void ATimeRewindController::FireProjectile()
 		currProjectileIndex = 0; //reset projectile index
 	}
 
-	//Get current projectile
+	//Get current projectile and its timeline handle
 	APhysicsChairProjectile* chairProjectile = projectileList[currProjectileIndex];
+	FTimelineHandle projectileHandle = projectileHandleList[currProjectileIndex];
 
 	//Grab collision component from projectile
 	UActorComponent* foundComponent = chairProjectile->GetComponentByClass(UShapeComponent::StaticClass());
@@ -139,7 +161,7 @@ void ATimeRewindController::FireProjectile()
 	//If time rewind manager, manually update the timeline with a reset position as if a new projectile spawn
 	if (timeRewindManager != nullptr)
 	{
-		timeRewindManager->ManuallyUpdateTimelineObject(boxCollision);
+		timeRewindManager->ManuallyUpdateTimelineHandle(projectileHandle);
 	}
 }
 
@@ -147,6 +169,13 @@ void ATimeRewindController::FireProjectile()
 //Function to enable rewind playback exposed to BP for usage in subclasses
 void ATimeRewindController::EnablePlayback(bool enablePlayback)
 {
+	//the server owns the timeline, clients follow once it replicates the change
+	if (!HasAuthority())
+	{
+		ServerEnablePlayback(enablePlayback);
+		return;
+	}
+
 	if (timeRewindManager != nullptr)
 	{
 		timeRewindManager->EnablePlayback(enablePlayback);
@@ -156,6 +185,12 @@ void ATimeRewindController::EnablePlayback(bool enablePlayback)
 //Function to paused and unpause timeline playback exposed to BP for usage in subclasses
 void ATimeRewindController::PausePlayback(bool shouldPause)
 {
+	if (!HasAuthority())
+	{
+		ServerPausePlayback(shouldPause);
+		return;
+	}
+
 	if (timeRewindManager != nullptr)
 	{
 		timeRewindManager->PausePlayback(shouldPause);
@@ -165,12 +200,45 @@ void ATimeRewindController::PausePlayback(bool shouldPause)
 //Function to change time in playback timeline exposed to BP for usage in subclasses
 void ATimeRewindController::SeekTime(float timeValue)
 {
+	if (!HasAuthority())
+	{
+		ServerSeekTime(timeValue);
+		return;
+	}
+
 	if (timeRewindManager != nullptr)
 	{
 		timeRewindManager->SeekTime(timeValue);
 	}
 }
 
+//Ask the server to enable or disable playback for every player
+void ATimeRewindController::ServerEnablePlayback_Implementation(bool enablePlayback)
+{
+	EnablePlayback(enablePlayback);
+}
+
+//Ask the server to pause or unpause playback for every player
+void ATimeRewindController::ServerPausePlayback_Implementation(bool shouldPause)
+{
+	PausePlayback(shouldPause);
+}
+
+//Ask the server to change time in the playback timeline for every player
+void ATimeRewindController::ServerSeekTime_Implementation(float timeValue)
+{
+	SeekTime(timeValue);
+}
+
+//Receive playback states from the server for objects this client recorded differently
+void ATimeRewindController::ClientReceiveTimelineCorrections_Implementation(const TArray<uint8>& packet)
+{
+	if (timeRewindManager != nullptr)
+	{
+		timeRewindManager->ApplyTimelineCorrections(packet);
+	}
+}
+
 //Function to check if playback is paused exposed to BP for usage in subclasses
 bool ATimeRewindController::GetIsPlaybackPaused()
 {
@@ -13,7 +13,6 @@
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
 #include "RewindStruct.h"
-#include "TimeArrayStruct.h"
 #include "Components/BoxComponent.h"
 #include "Components/ShapeComponent.h"
 #include "PhysicsChairProjectile.h"
@@ -50,6 +49,11 @@ public:
 	UPROPERTY(VisibleDefaultsOnly, Category = Actors)
 	TArray<APhysicsChairProjectile*> projectileList;
 
+	//Timeline handles for each pre-spawned projectile, matching the order of projectileList
+	//Exposed to BP to be used in subclass blueprints
+	UPROPERTY(VisibleDefaultsOnly, Category = Actors)
+	TArray<FTimelineHandle> projectileHandleList;
+
 	//Exposed to BP to be writeable for different launching sounds
 	//Used in BP_TimeRewindController
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
@@ -99,4 +103,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Playback")
 	bool GetIsPlaybackPaused();
 
+	//Ask the server to enable or disable playback for every player
+	UFUNCTION(Server, Reliable)
+	void ServerEnablePlayback(bool enablePlayback);
+
+	//Ask the server to pause or unpause playback for every player
+	UFUNCTION(Server, Reliable)
+	void ServerPausePlayback(bool shouldPause);
+
+	//Ask the server to change time in the playback timeline for every player
+	UFUNCTION(Server, Reliable)
+	void ServerSeekTime(float timeValue);
+
+	//Receive playback states from the server for objects this client recorded differently
+	UFUNCTION(Client, Reliable)
+	void ClientReceiveTimelineCorrections(const TArray<uint8>& packet);
+
 };
@@ -7,23 +7,10 @@
 //THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 
-#include "TimeArrayStruct.h"
+#include "TimelineActivityBucket.h"
 
-
-//default constructor
-FTimeArrayStruct::FTimeArrayStruct()
+//Check if anything happened during this span
+bool FTimelineActivityBucket::IsEmpty() const
 {
-	//Initialize timeline with default objects and size
-	TimePoints.Init(FRewindStruct(), 500);
+	return movingObjects == 0 && impacts == 0 && fireEvents == 0;
 }
-
-//constructor to create timeline array of a specific size based on how long you want to record
-//num position is the number of positions in the array to hold
-FTimeArrayStruct::FTimeArrayStruct(int numPositions)
-{
-	//only allow array creation with a valid value
-	if (numPositions > -1)
-	{
-		TimePoints.Init(FRewindStruct(), numPositions);
-	}
-}
\ No newline at end of file
@@ -0,0 +1,36 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "TimelineActivityBucket.generated.h"
+
+/**
+ * Struct to summarize timeline activity over a span of recorded time for the playback scrub bar
+ */
+USTRUCT(BlueprintType)
+struct TIMEREWIND_API FTimelineActivityBucket
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Properties all exposed to BP for use in the playback UI */
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 movingObjects = 0; //most objects moving at once during this span
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 impacts = 0; //number of sudden velocity changes during this span
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 fireEvents = 0; //number of manual timeline updates such as projectile launches during this span
+
+	//Check if anything happened during this span
+	bool IsEmpty() const;
+};
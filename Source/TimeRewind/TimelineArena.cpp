@@ -0,0 +1,174 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineArena.h"
+#include "TimeRewind.h"
+
+FTimelineArena::~FTimelineArena()
+{
+	FreeOverflowPages();
+
+	if (memory != nullptr)
+	{
+		FMemory::Free(memory);
+		memory = nullptr;
+	}
+}
+
+//Reserve the block for a number of bytes
+void FTimelineArena::Init(int64 reserveBytes)
+{
+	//release any previous block
+	FreeOverflowPages();
+
+	if (memory != nullptr)
+	{
+		FMemory::Free(memory);
+		memory = nullptr;
+	}
+
+	numPages = int32(FMath::Max<int64>(reserveBytes, 0) / PageSize);
+	memory = numPages > 0 ? static_cast<uint8*>(FMemory::Malloc(SIZE_T(numPages) * PageSize, 16)) : nullptr;
+	isInitialized = true;
+
+	Reset();
+}
+
+//Check if Init has been called, even if it reserved no pages
+bool FTimelineArena::IsInitialized() const
+{
+	return isInitialized;
+}
+
+//Take a page
+uint8* FTimelineArena::AllocatePage()
+{
+	uint8* page = nullptr;
+
+	//recycle a returned page first
+	if (freeListHead != nullptr)
+	{
+		page = freeListHead;
+		FMemory::Memcpy(&freeListHead, page, sizeof(uint8*));
+	}
+	//otherwise take the next page never handed out
+	else if (nextUnusedPage < numPages)
+	{
+		page = memory + SIZE_T(nextUnusedPage) * PageSize;
+		nextUnusedPage++;
+	}
+	//the block is full, so keep recording on the heap rather than dropping positions
+	else
+	{
+		if (!isExhaustionReported)
+		{
+			UE_LOG(LogTimeRewind, Warning, TEXT("Timeline arena is full after %lld bytes, taking pages from the heap. Raise timelineArenaMegabytes to keep recording in the arena."),
+				GetReservedBytes());
+			isExhaustionReported = true;
+		}
+
+		page = static_cast<uint8*>(FMemory::Malloc(PageSize, 16));
+		overflowPages.Add(page);
+		numOverflowAllocations++;
+	}
+
+	numUsedPages++;
+
+	return page;
+}
+
+//Return a page taken from this arena
+void FTimelineArena::FreePage(uint8* page)
+{
+	if (page == nullptr)
+	{
+		return;
+	}
+
+	numUsedPages--;
+
+	//heap pages go straight back to the heap
+	if (!IsBlockPage(page))
+	{
+		overflowPages.Remove(page);
+		FMemory::Free(page);
+
+		//the arena fits in its block again, so running out next time is reported again
+		if (overflowPages.Num() == 0)
+		{
+			isExhaustionReported = false;
+		}
+
+		return;
+	}
+
+	//push onto the free list, storing the old head in the page itself
+	FMemory::Memcpy(page, &freeListHead, sizeof(uint8*));
+	freeListHead = page;
+}
+
+//Return every page at once
+void FTimelineArena::Reset()
+{
+	FreeOverflowPages();
+
+	nextUnusedPage = 0;
+	freeListHead = nullptr;
+	numUsedPages = 0;
+	numOverflowAllocations = 0;
+	isExhaustionReported = false;
+	resetCount++;
+}
+
+//Number of times the arena was reset
+uint32 FTimelineArena::GetResetCount() const
+{
+	return resetCount;
+}
+
+//Bytes reserved for the arena
+int64 FTimelineArena::GetReservedBytes() const
+{
+	return int64(numPages) * PageSize;
+}
+
+//Bytes in pages currently handed out
+int64 FTimelineArena::GetUsedBytes() const
+{
+	return int64(numUsedPages) * PageSize;
+}
+
+//Bytes in pages currently taken from the heap because the block was full
+int64 FTimelineArena::GetOverflowBytes() const
+{
+	return int64(overflowPages.Num()) * PageSize;
+}
+
+//Number of pages taken from the heap because the block was full
+int32 FTimelineArena::GetNumOverflowAllocations() const
+{
+	return numOverflowAllocations;
+}
+
+//Check if a page is part of the reserved block
+bool FTimelineArena::IsBlockPage(const uint8* page) const
+{
+	return memory != nullptr && page >= memory && page < memory + SIZE_T(numPages) * PageSize;
+}
+
+//Give every page taken from the heap back to it
+void FTimelineArena::FreeOverflowPages()
+{
+	for (uint8* page : overflowPages)
+	{
+		FMemory::Free(page);
+	}
+
+	overflowPages.Reset();
+}
@@ -0,0 +1,98 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Single preallocated block of memory carved into fixed-size pages for timeline storage.
+ * Pages are handed out from a bump pointer and recycled through an intrusive free list, so allocating
+ * and freeing a page is O(1) and never touches the general allocator. Resetting the whole arena is O(1)
+ * and the footprint is the reserved block, unless the block runs out and pages overflow onto the heap.
+ */
+class TIMEREWIND_API FTimelineArena
+{
+public:
+	//bytes in each page
+	static constexpr int32 PageSize = 4096;
+
+	FTimelineArena() {}
+	~FTimelineArena();
+
+	//the arena owns its block, so it cannot be copied
+	FTimelineArena(const FTimelineArena&) = delete;
+	FTimelineArena& operator=(const FTimelineArena&) = delete;
+
+	//Reserve the block for a number of bytes, rounded down to whole pages. An empty block takes every page from the heap
+	void Init(int64 reserveBytes);
+
+	//Check if Init has been called, even if it reserved no pages
+	bool IsInitialized() const;
+
+	//Take a page. Once every page of the block is in use, pages come from the heap until enough are returned
+	uint8* AllocatePage();
+
+	//Return a page taken from this arena
+	void FreePage(uint8* page);
+
+	//Return every page at once. Pages handed out before the reset must not be freed afterwards
+	void Reset();
+
+	//Number of times the arena was reset, used by owners of pages to know their pages were already returned
+	uint32 GetResetCount() const;
+
+	//Bytes reserved for the arena
+	int64 GetReservedBytes() const;
+
+	//Bytes in pages currently handed out, including pages taken from the heap
+	int64 GetUsedBytes() const;
+
+	//Bytes in pages currently taken from the heap because the block was full
+	int64 GetOverflowBytes() const;
+
+	//Number of pages taken from the heap because the block was full since the last reset
+	int32 GetNumOverflowAllocations() const;
+
+private:
+	//reserved block
+	uint8* memory = nullptr;
+
+	//number of pages in the block
+	int32 numPages = 0;
+
+	//has Init been called, the block can be empty so this is tracked separately from memory
+	bool isInitialized = false;
+
+	//index of the first page never handed out since the last reset
+	int32 nextUnusedPage = 0;
+
+	//first returned page, each free page stores the next one in its first bytes
+	uint8* freeListHead = nullptr;
+
+	//number of pages handed out
+	int32 numUsedPages = 0;
+
+	//pages taken from the heap because the block was full, freed back to the heap when returned or reset
+	TSet<uint8*> overflowPages;
+
+	//number of pages taken from the heap because the block was full
+	int32 numOverflowAllocations = 0;
+
+	//has running out of the block been reported since the arena last fit in it
+	bool isExhaustionReported = false;
+
+	//number of times the arena was reset
+	uint32 resetCount = 0;
+
+	//Check if a page is part of the reserved block
+	bool IsBlockPage(const uint8* page) const;
+
+	//Give every page taken from the heap back to it
+	void FreeOverflowPages();
+};
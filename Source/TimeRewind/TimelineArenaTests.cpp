@@ -0,0 +1,75 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineArena.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineArenaPagesTest, "TimeRewind.Arena.PagesAndOverflow", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Fill a small arena past its block, return pages and reset it, checking the counts the manager reports
+bool FTimelineArenaPagesTest::RunTest(const FString& Parameters)
+{
+	FTimelineArena arena;
+	arena.Init(FTimelineArena::PageSize * 2);
+
+	TestTrue(TEXT("Arena is initialized"), arena.IsInitialized());
+	TestEqual(TEXT("Reserved bytes are whole pages"), arena.GetReservedBytes(), int64(FTimelineArena::PageSize * 2));
+
+	uint8* firstPage = arena.AllocatePage();
+	uint8* secondPage = arena.AllocatePage();
+
+	TestNotNull(TEXT("First page"), firstPage);
+	TestNotNull(TEXT("Second page"), secondPage);
+	TestTrue(TEXT("Pages do not overlap"), FMath::Abs(secondPage - firstPage) >= FTimelineArena::PageSize);
+	TestEqual(TEXT("Used bytes after filling the block"), arena.GetUsedBytes(), int64(FTimelineArena::PageSize * 2));
+
+	//a returned page is the next one handed out
+	arena.FreePage(firstPage);
+	TestEqual(TEXT("Returned page is recycled"), arena.AllocatePage(), firstPage);
+
+	//running out is reported once however many pages overflow
+	AddExpectedError(TEXT("Timeline arena is full"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	uint8* firstOverflowPage = arena.AllocatePage();
+	uint8* secondOverflowPage = arena.AllocatePage();
+
+	TestNotNull(TEXT("Full arena still hands out pages"), firstOverflowPage);
+	TestNotNull(TEXT("Full arena keeps handing out pages"), secondOverflowPage);
+	TestEqual(TEXT("Overflow pages are counted"), arena.GetNumOverflowAllocations(), 2);
+	TestEqual(TEXT("Overflow bytes"), arena.GetOverflowBytes(), int64(FTimelineArena::PageSize * 2));
+	TestEqual(TEXT("Used bytes include overflow pages"), arena.GetUsedBytes(), int64(FTimelineArena::PageSize * 4));
+
+	//overflow pages go back to the heap rather than onto the free list
+	arena.FreePage(firstOverflowPage);
+	arena.FreePage(secondOverflowPage);
+	TestEqual(TEXT("No overflow bytes once returned"), arena.GetOverflowBytes(), int64(0));
+	TestEqual(TEXT("Used bytes once overflow pages are returned"), arena.GetUsedBytes(), int64(FTimelineArena::PageSize * 2));
+
+	//resetting returns every page at once
+	uint32 resetCount = arena.GetResetCount();
+	arena.Reset();
+
+	TestEqual(TEXT("Reset count increases"), arena.GetResetCount(), resetCount + 1);
+	TestEqual(TEXT("No used bytes after reset"), arena.GetUsedBytes(), int64(0));
+	TestEqual(TEXT("Overflow count is cleared by reset"), arena.GetNumOverflowAllocations(), 0);
+	TestNotNull(TEXT("Pages are handed out again after reset"), arena.AllocatePage());
+
+	//an arena reserving no pages is still initialized, so its owners do not initialize it again over live pages
+	FTimelineArena emptyArena;
+	emptyArena.Init(0);
+
+	TestTrue(TEXT("Empty arena is initialized"), emptyArena.IsInitialized());
+	TestEqual(TEXT("Empty arena reserves nothing"), emptyArena.GetReservedBytes(), int64(0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,89 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineBranch.h"
+
+//default constructor
+FTimelineBranch::FTimelineBranch()
+{
+}
+
+//constructor for a new branch covering the abandoned range of the timeline
+FTimelineBranch::FTimelineBranch(int32 newBranchId, int64 newForkTick, int64 newEndTick)
+	: branchId(newBranchId)
+	, forkTick(newForkTick)
+	, endTick(newEndTick)
+{
+}
+
+//Check if this branch holds a position for the absolute tick
+bool FTimelineBranch::ContainsTick(int64 tick) const
+{
+	return tick < endTick;
+}
+
+//Check if the main timeline overwriting this tick requires copying it into the branch first
+bool FTimelineBranch::NeedsCopy(int64 tick) const
+{
+	//anything before the end of the branch is shared until copied
+	return ContainsTick(tick) && !copiedTickMap.Contains(tick);
+}
+
+//Find the copy index holding copied positions for an absolute tick
+const int32* FTimelineBranch::FindCopyIndex(int64 tick) const
+{
+	return copiedTickMap.Find(tick);
+}
+
+//Find the copied position for a timeline slot at a copy index
+const FRewindStruct* FTimelineBranch::FindCopiedPoint(const FTimelineHandle& handle, int32 copyIndex) const
+{
+	//if slot never copied anything, there is nothing to return
+	if (!copiedPoints.IsValidIndex(handle.slotIndex))
+	{
+		return nullptr;
+	}
+
+	//if slot was recycled for another object since copying, the copies belong to the old object
+	const FTimelineBranchPoints& slotPoints = copiedPoints[handle.slotIndex];
+
+	if (slotPoints.generation != handle.generation || !slotPoints.points.IsValidIndex(copyIndex))
+	{
+		return nullptr;
+	}
+
+	return &slotPoints.points[copyIndex];
+}
+
+//Copy a position for a timeline slot into a copy index
+void FTimelineBranch::CopyPoint(const FTimelineHandle& handle, int32 copyIndex, const FRewindStruct& point)
+{
+	//grow slot list to hold this slot
+	if (copiedPoints.Num() <= handle.slotIndex)
+	{
+		copiedPoints.SetNum(handle.slotIndex + 1);
+	}
+
+	FTimelineBranchPoints& slotPoints = copiedPoints[handle.slotIndex];
+
+	//if slot was recycled for another object, drop copies of the old object
+	if (slotPoints.generation != handle.generation)
+	{
+		slotPoints.generation = handle.generation;
+		slotPoints.points.Reset();
+	}
+
+	//grow copies to hold this index, filling any ticks this object missed with null positions
+	if (slotPoints.points.Num() <= copyIndex)
+	{
+		slotPoints.points.SetNum(copyIndex + 1);
+	}
+
+	slotPoints.points[copyIndex] = point;
+}
@@ -0,0 +1,73 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RewindStruct.h"
+#include "TimelineHandle.h"
+
+/**
+ * Positions a branch copied for one timeline slot
+ */
+struct TIMEREWIND_API FTimelineBranchPoints
+{
+	//generation of the slot these positions were copied from
+	int32 generation = 0;
+
+	//copied positions, indexed by the copy index from the branch tick map
+	TArray<FRewindStruct> points;
+};
+
+/**
+ * Read-only timeline branch kept when playback resumes from an earlier point.
+ * A branch shares every position with the main timeline until the main timeline overwrites it.
+ * Positions are only copied into the branch right before they would be overwritten (copy-on-write),
+ * so keeping a branch costs nothing until new recording diverges from it.
+ */
+struct TIMEREWIND_API FTimelineBranch
+{
+	//unique id of this branch used by blueprint to enumerate, seek and delete branches
+	int32 branchId = INDEX_NONE;
+
+	//absolute recording tick the main timeline diverged from this branch
+	int64 forkTick = 0;
+
+	//absolute recording tick one past the last valid position of this branch
+	int64 endTick = 0;
+
+	//Maps absolute recording tick to the copy index holding its copied positions
+	//Ticks missing from this map are still shared with the main timeline
+	TMap<int64, int32> copiedTickMap;
+
+	//Copied positions for each timeline slot, indexed by slot index
+	TArray<FTimelineBranchPoints> copiedPoints;
+
+	//default constructor
+	FTimelineBranch();
+
+	//constructor for a new branch covering the abandoned range of the timeline
+	FTimelineBranch(int32 newBranchId, int64 newForkTick, int64 newEndTick);
+
+	//Check if this branch holds a position for the absolute tick
+	bool ContainsTick(int64 tick) const;
+
+	//Check if the main timeline overwriting this tick requires copying it into the branch first
+	bool NeedsCopy(int64 tick) const;
+
+	//Find the copy index holding copied positions for an absolute tick
+	//Returns nullptr if the tick is still shared with the main timeline
+	const int32* FindCopyIndex(int64 tick) const;
+
+	//Find the copied position for a timeline slot at a copy index
+	//Returns nullptr if the object was not tracked when the tick was copied
+	const FRewindStruct* FindCopiedPoint(const FTimelineHandle& handle, int32 copyIndex) const;
+
+	//Copy a position for a timeline slot into a copy index
+	void CopyPoint(const FTimelineHandle& handle, int32 copyIndex, const FRewindStruct& point);
+};
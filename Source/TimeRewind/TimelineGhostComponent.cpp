@@ -0,0 +1,240 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineGhostComponent.h"
+
+//Constructor
+UTimelineGhostComponent::UTimelineGhostComponent()
+{
+	//ghosts only change when the playback window moves, so there is nothing to tick
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+//Create the instanced mesh and line batch used to draw ghosts
+void UTimelineGhostComponent::InitializeGhosts(UStaticMesh* ghostMesh, UMaterialInterface* ghostMaterial, int newGhostsPerSide, int newGhostStride, bool shouldDrawTrajectories)
+{
+	//clamp settings to usable values
+	ghostsPerSide = FMath::Max(newGhostsPerSide, 0);
+	ghostStride = FMath::Max(newGhostStride, 1);
+	drawTrajectories = shouldDrawTrajectories;
+
+	AActor* owner = GetOwner();
+
+	//create the instanced mesh for ghost poses at the world origin so instance transforms are world transforms
+	if (ghostInstances == nullptr && ghostMesh != nullptr)
+	{
+		//the owner may still hold the instances of a destroyed ghost component, so the name must be unique
+		ghostInstances = NewObject<UInstancedStaticMeshComponent>(owner, MakeUniqueObjectName(owner, UInstancedStaticMeshComponent::StaticClass(), TEXT("TimelineGhostInstances")));
+		ghostInstances->SetUsingAbsoluteLocation(true);
+		ghostInstances->SetUsingAbsoluteRotation(true);
+		ghostInstances->SetUsingAbsoluteScale(true);
+		ghostInstances->SetStaticMesh(ghostMesh);
+		//ghosts are visual only
+		ghostInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		ghostInstances->SetCastShadow(false);
+		//custom data 0 holds the timeline step of each ghost
+		ghostInstances->NumCustomDataFloats = 1;
+		ghostInstances->RegisterComponent();
+		ghostInstances->SetWorldTransform(FTransform::Identity);
+
+		//material instance to pass the playback step to the ghost material
+		if (ghostMaterial != nullptr)
+		{
+			ghostMaterialInstance = UMaterialInstanceDynamic::Create(ghostMaterial, this);
+			ghostInstances->SetMaterial(0, ghostMaterialInstance);
+		}
+	}
+
+	//create the line batch for trajectories
+	if (trajectoryLines == nullptr && drawTrajectories)
+	{
+		trajectoryLines = NewObject<ULineBatchComponent>(owner, MakeUniqueObjectName(owner, ULineBatchComponent::StaticClass(), TEXT("TimelineGhostTrajectories")));
+		trajectoryLines->RegisterComponent();
+	}
+
+	isDirty = true;
+}
+
+//Rebuild every ghost and trajectory around a playback index
+void UTimelineGhostComponent::RebuildGhosts(int32 numObjects, int numPositions, int playbackIndex, FGhostSampler sampler)
+{
+	numGhostObjects = numObjects;
+	numTimelinePositions = numPositions;
+	centerStep = playbackIndex / ghostStride;
+	isDirty = false;
+
+	if (ghostInstances != nullptr)
+	{
+		//add a hidden instance for every ghost in every object's ring in one call
+		int32 numInstances = numGhostObjects * GetGhostsPerObject();
+		TArray<FTransform> hiddenTransforms;
+		hiddenTransforms.Init(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), numInstances);
+
+		ghostInstances->ClearInstances();
+		ghostInstances->AddInstances(hiddenTransforms, false);
+
+		//write the ghosts inside the current window
+		for (int32 objectIndex = 0; objectIndex < numGhostObjects; objectIndex++)
+		{
+			for (int step = centerStep - ghostsPerSide; step <= centerStep + ghostsPerSide; step++)
+			{
+				WriteGhost(objectIndex, step, sampler);
+			}
+		}
+
+		UpdatePlaybackStep();
+		ghostInstances->MarkRenderStateDirty();
+	}
+
+	RebuildTrajectories(sampler);
+}
+
+//Slide the ghost window to a new playback index, only updating ghosts that enter the window
+void UTimelineGhostComponent::UpdateGhostWindow(int playbackIndex, FGhostSampler sampler)
+{
+	//a full rebuild is required before the window can slide
+	if (isDirty || ghostInstances == nullptr)
+	{
+		return;
+	}
+
+	int newCenterStep = playbackIndex / ghostStride;
+	int stepDelta = newCenterStep - centerStep;
+
+	//skip if the window did not move
+	if (stepDelta == 0)
+	{
+		return;
+	}
+
+	//Steps that enter the window replace the ring slots of steps that left it
+	//If the window jumped further than its width, every step is new
+	int firstStep = stepDelta > 0 ? FMath::Max(centerStep + ghostsPerSide + 1, newCenterStep - ghostsPerSide) : newCenterStep - ghostsPerSide;
+	int lastStep = stepDelta > 0 ? newCenterStep + ghostsPerSide : FMath::Min(centerStep - ghostsPerSide - 1, newCenterStep + ghostsPerSide);
+
+	centerStep = newCenterStep;
+
+	for (int32 objectIndex = 0; objectIndex < numGhostObjects; objectIndex++)
+	{
+		for (int step = firstStep; step <= lastStep; step++)
+		{
+			WriteGhost(objectIndex, step, sampler);
+		}
+	}
+
+	//single render state update for every ghost written
+	UpdatePlaybackStep();
+	ghostInstances->MarkRenderStateDirty();
+}
+
+//Flag the ghosts for a full rebuild
+void UTimelineGhostComponent::MarkGhostsDirty()
+{
+	isDirty = true;
+}
+
+//Check if the ghosts need a full rebuild before the window can slide
+bool UTimelineGhostComponent::NeedsRebuild() const
+{
+	return isDirty;
+}
+
+//Destroy the ghost components along with this one
+void UTimelineGhostComponent::OnUnregister()
+{
+	if (ghostInstances != nullptr)
+	{
+		ghostInstances->DestroyComponent();
+		ghostInstances = nullptr;
+	}
+
+	if (trajectoryLines != nullptr)
+	{
+		trajectoryLines->DestroyComponent();
+		trajectoryLines = nullptr;
+	}
+
+	Super::OnUnregister();
+}
+
+//Number of ghost instances in each object's ring
+int UTimelineGhostComponent::GetGhostsPerObject() const
+{
+	return ghostsPerSide * 2 + 1;
+}
+
+//Write the ghost for an object at a timeline step into its ring slot
+void UTimelineGhostComponent::WriteGhost(int32 objectIndex, int step, FGhostSampler sampler)
+{
+	//each step always maps to the same slot in the object's ring, including steps before the timeline start
+	int ringSlot = ((step % GetGhostsPerObject()) + GetGhostsPerObject()) % GetGhostsPerObject();
+	int32 instanceIndex = objectIndex * GetGhostsPerObject() + ringSlot;
+
+	//steps outside the timeline or without a recorded position are hidden with a zero scale
+	int timelineIndex = step * ghostStride;
+	FRewindStruct point;
+	bool hasPoint = timelineIndex >= 0 && timelineIndex < numTimelinePositions && sampler(objectIndex, timelineIndex, point);
+
+	FTransform ghostTransform = hasPoint
+		? FTransform(point.rotation, point.position)
+		: FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+
+	//update without marking render state dirty, callers mark it once after all writes
+	ghostInstances->UpdateInstanceTransform(instanceIndex, ghostTransform, false, false, true);
+	ghostInstances->SetCustomDataValue(instanceIndex, 0, float(step), false);
+}
+
+//Redraw every trajectory line
+void UTimelineGhostComponent::RebuildTrajectories(FGhostSampler sampler)
+{
+	if (trajectoryLines == nullptr)
+	{
+		return;
+	}
+
+	//clear old trajectories
+	trajectoryLines->Flush();
+
+	//build every segment into one array so the batch is updated once
+	TArray<FBatchedLine> lines;
+	const FLinearColor lineColor = FLinearColor(0.2f, 0.8f, 1.0f);
+
+	for (int32 objectIndex = 0; objectIndex < numGhostObjects; objectIndex++)
+	{
+		FRewindStruct prevPoint;
+		bool hasPrevPoint = false;
+
+		//connect each ghost step to the next one
+		for (int timelineIndex = 0; timelineIndex < numTimelinePositions; timelineIndex += ghostStride)
+		{
+			FRewindStruct point;
+			bool hasPoint = sampler(objectIndex, timelineIndex, point);
+
+			//do not connect across gaps or teleports
+			if (hasPrevPoint && hasPoint && !point.resetPosition)
+			{
+				lines.Add(FBatchedLine(prevPoint.position, point.position, lineColor, 0.0f, 1.0f, SDPG_World));
+			}
+
+			prevPoint = point;
+			hasPrevPoint = hasPoint;
+		}
+	}
+
+	trajectoryLines->DrawLines(lines);
+}
+
+//Pass the current playback step to the ghost material
+void UTimelineGhostComponent::UpdatePlaybackStep()
+{
+	if (ghostMaterialInstance != nullptr)
+	{
+		ghostMaterialInstance->SetScalarParameterValue(FName("PlaybackStep"), float(centerStep));
+	}
+}
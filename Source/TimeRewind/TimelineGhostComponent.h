@@ -0,0 +1,96 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/LineBatchComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "RewindStruct.h"
+#include "TimelineGhostComponent.generated.h"
+
+/**
+ * Onion-skin visualization of recorded timelines for the playback scrubber.
+ * Every ghost pose is an instance of a single instanced static mesh and every trajectory is a line in a single
+ * line batch, so thousands of ghosts draw in a handful of draw calls.
+ * Each object owns a ring of ghost instances. Sliding the playback window only rewrites the ghosts
+ * that enter the window instead of every ghost.
+ *
+ * The ghost material receives the ghost's timeline step in per-instance custom data 0 and the current playback step
+ * in the "PlaybackStep" scalar parameter, so it can tint past and future ghosts without touching every instance.
+ */
+UCLASS(ClassGroup = (Custom))
+class TIMEREWIND_API UTimelineGhostComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	//Reads a recorded position by dense object index and timeline index. Returns false for missing positions
+	typedef TFunctionRef<bool (int32, int, FRewindStruct&)> FGhostSampler;
+
+	//Constructor
+	UTimelineGhostComponent();
+
+	//Create the instanced mesh and line batch used to draw ghosts
+	void InitializeGhosts(UStaticMesh* ghostMesh, UMaterialInterface* ghostMaterial, int newGhostsPerSide, int newGhostStride, bool shouldDrawTrajectories);
+
+	//Rebuild every ghost and trajectory around a playback index
+	void RebuildGhosts(int32 numObjects, int numPositions, int playbackIndex, FGhostSampler sampler);
+
+	//Slide the ghost window to a new playback index, only updating ghosts that enter the window
+	void UpdateGhostWindow(int playbackIndex, FGhostSampler sampler);
+
+	//Flag the ghosts for a full rebuild, such as when tracked objects are added or removed
+	void MarkGhostsDirty();
+
+	//Check if the ghosts need a full rebuild before the window can slide
+	bool NeedsRebuild() const;
+
+protected:
+	//Destroy the ghost components along with this one
+	virtual void OnUnregister() override;
+
+private:
+	//instanced mesh holding every ghost pose
+	UPROPERTY()
+	UInstancedStaticMeshComponent* ghostInstances;
+
+	//line batch holding every trajectory
+	UPROPERTY()
+	ULineBatchComponent* trajectoryLines;
+
+	//material instance used to pass the playback step to the ghost material
+	UPROPERTY()
+	UMaterialInstanceDynamic* ghostMaterialInstance;
+
+	//number of ghosts drawn on each side of the playback index
+	int ghostsPerSide = 8;
+	//number of timeline positions between ghosts
+	int ghostStride = 5;
+	//should trajectories be drawn
+	bool drawTrajectories = true;
+	//number of objects the ghosts were last built for
+	int32 numGhostObjects = 0;
+	//number of positions in each timeline
+	int numTimelinePositions = 0;
+	//step at the center of the ghost window, INDEX_NONE before the first build
+	int centerStep = INDEX_NONE;
+	//should the ghosts be rebuilt before the next slide
+	bool isDirty = true;
+
+	//Number of ghost instances in each object's ring
+	int GetGhostsPerObject() const;
+	//Write the ghost for an object at a timeline step into its ring slot
+	void WriteGhost(int32 objectIndex, int step, FGhostSampler sampler);
+	//Redraw every trajectory line
+	void RebuildTrajectories(FGhostSampler sampler);
+	//Pass the current playback step to the ghost material
+	void UpdatePlaybackStep();
+};
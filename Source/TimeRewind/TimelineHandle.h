@@ -0,0 +1,49 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "TimelineHandle.generated.h"
+
+/**
+ * Generational handle to a tracked object's timeline slot.
+ * The generation changes every time a slot is recycled, so handles to removed objects stop resolving
+ * instead of pointing at whatever object reused the slot.
+ */
+USTRUCT(BlueprintType)
+struct TIMEREWIND_API FTimelineHandle
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Properties exposed to BP as read only so handles can be stored in subclasses */
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 slotIndex = INDEX_NONE; //index of the slot in the handle table
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 generation = 0; //generation of the slot when this handle was issued
+
+	//default constructor
+	FTimelineHandle();
+
+	//constructor for a handle to a specific slot generation
+	FTimelineHandle(int32 newSlotIndex, int32 newGeneration);
+
+	//Check if this handle was ever issued. Issued handles may still be stale
+	bool IsSet() const;
+
+	bool operator==(const FTimelineHandle& other) const;
+	bool operator!=(const FTimelineHandle& other) const;
+
+	friend uint32 GetTypeHash(const FTimelineHandle& handle)
+	{
+		return HashCombine(::GetTypeHash(handle.slotIndex), ::GetTypeHash(handle.generation));
+	}
+};
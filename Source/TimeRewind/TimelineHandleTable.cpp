@@ -0,0 +1,162 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineHandleTable.h"
+
+//Add a collision object and create its timeline with the number of positions to record and the layout to store
+FTimelineHandle FTimelineHandleTable::Add(UShapeComponent* physicsObj, int numPositions, ETimelineLayout layout, const FTimelineStorageSettings& storage)
+{
+	//if already tracked, return the existing handle
+	FTimelineHandle existingHandle = FindHandle(physicsObj);
+
+	if (existingHandle.IsSet())
+	{
+		return existingHandle;
+	}
+
+	//recycle a free slot if there is one, otherwise create a new slot
+	int32 slotIndex = freeSlots.Num() > 0 ? freeSlots.Pop(false) : slots.AddDefaulted();
+	FTimelineSlot& newSlot = slots[slotIndex];
+
+	//point slot at the new object
+	newSlot.physicsObj = physicsObj;
+	newSlot.objectKey = TObjectKey<UShapeComponent>(physicsObj);
+
+	//A recycled slot reuses its previous timeline if it has the same layout
+	//keyframe timelines hold no arena pages and their settings can change between levels, so they are always recreated
+	TUniquePtr<FTimeline> layoutTimeline = FTimeline::Create(layout, storage);
+	bool isKeyframeLayout = layout == ETimelineLayout::Snapshots || layout == ETimelineLayout::Extrapolated;
+
+	if (!newSlot.timeline.IsValid() || newSlot.timeline->GetLayout() != layout || isKeyframeLayout)
+	{
+		newSlot.timeline = MoveTemp(layoutTimeline);
+	}
+
+	//reset timeline to null positions
+	newSlot.timeline->Init(numPositions);
+	newSlot.playbackState = FTimelinePlaybackState();
+	newSlot.spatialCursor = FTimelineSpatialCursor();
+	newSlot.boundsRadius = 0.0f;
+	newSlot.netId = 0;
+	newSlot.hasCorrection = false;
+
+	//add slot to the dense list of active slots
+	newSlot.denseIndex = denseSlots.Add(slotIndex);
+	objectSlotMap.Add(newSlot.objectKey, slotIndex);
+
+	return FTimelineHandle(slotIndex, newSlot.generation);
+}
+
+//Remove a slot and recycle it
+bool FTimelineHandleTable::Remove(const FTimelineHandle& handle)
+{
+	FTimelineSlot* foundSlot = Get(handle);
+
+	//if handle is stale, the slot was already removed
+	if (foundSlot == nullptr)
+	{
+		return false;
+	}
+
+	//remove from the dense list by swapping the last active slot into its place
+	int32 denseIndex = foundSlot->denseIndex;
+	denseSlots.RemoveAtSwap(denseIndex, 1, false);
+
+	if (denseSlots.IsValidIndex(denseIndex))
+	{
+		slots[denseSlots[denseIndex]].denseIndex = denseIndex;
+	}
+
+	objectSlotMap.Remove(foundSlot->objectKey);
+
+	//clear slot and increase generation so old handles stop resolving
+	foundSlot->physicsObj.Reset();
+	foundSlot->objectKey = TObjectKey<UShapeComponent>();
+	foundSlot->timeline->Reset();
+	foundSlot->denseIndex = INDEX_NONE;
+	foundSlot->generation++;
+
+	freeSlots.Add(handle.slotIndex);
+
+	return true;
+}
+
+//Remove every slot and invalidate every handle
+void FTimelineHandleTable::Reset()
+{
+	//remove each active slot so generations still increase for recycled slots
+	while (denseSlots.Num() > 0)
+	{
+		int32 slotIndex = denseSlots.Last();
+		Remove(FTimelineHandle(slotIndex, slots[slotIndex].generation));
+	}
+}
+
+//Resolve a handle to its slot
+FTimelineSlot* FTimelineHandleTable::Get(const FTimelineHandle& handle)
+{
+	//only resolve handles to active slots of the same generation
+	if (!slots.IsValidIndex(handle.slotIndex))
+	{
+		return nullptr;
+	}
+
+	FTimelineSlot& foundSlot = slots[handle.slotIndex];
+
+	if (foundSlot.generation != handle.generation || foundSlot.denseIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return &foundSlot;
+}
+
+//Resolve a handle to its slot
+const FTimelineSlot* FTimelineHandleTable::Get(const FTimelineHandle& handle) const
+{
+	return const_cast<FTimelineHandleTable*>(this)->Get(handle);
+}
+
+//Find the handle for a tracked object
+FTimelineHandle FTimelineHandleTable::FindHandle(const UShapeComponent* physicsObj) const
+{
+	const int32* foundSlotIndex = objectSlotMap.Find(TObjectKey<UShapeComponent>(physicsObj));
+
+	if (foundSlotIndex == nullptr)
+	{
+		return FTimelineHandle();
+	}
+
+	return FTimelineHandle(*foundSlotIndex, slots[*foundSlotIndex].generation);
+}
+
+//Number of active slots
+int32 FTimelineHandleTable::Num() const
+{
+	return denseSlots.Num();
+}
+
+//Get the active slot at a dense index for iteration
+FTimelineSlot& FTimelineHandleTable::GetSlotAt(int32 denseIndex)
+{
+	return slots[denseSlots[denseIndex]];
+}
+
+//Get the active slot at a dense index for iteration
+const FTimelineSlot& FTimelineHandleTable::GetSlotAt(int32 denseIndex) const
+{
+	return slots[denseSlots[denseIndex]];
+}
+
+//Get the handle of the active slot at a dense index
+FTimelineHandle FTimelineHandleTable::GetHandleAt(int32 denseIndex) const
+{
+	int32 slotIndex = denseSlots[denseIndex];
+	return FTimelineHandle(slotIndex, slots[slotIndex].generation);
+}
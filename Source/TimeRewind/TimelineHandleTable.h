@@ -0,0 +1,112 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TimelineLayout.h"
+#include "TimelineHandle.h"
+#include "TimelineInterpolation.h"
+#include "TimelineSpatialIndex.h"
+#include "Components/ShapeComponent.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * Timeline slot for one tracked collision object
+ */
+struct TIMEREWIND_API FTimelineSlot
+{
+	//weak reference to the tracked object so destroyed components are detected instead of dereferenced
+	TWeakObjectPtr<UShapeComponent> physicsObj;
+
+	//key of the tracked object, valid even after the object is destroyed
+	TObjectKey<UShapeComponent> objectKey;
+
+	//recorded positions for this object, stored in the layout picked when the object was added
+	TUniquePtr<FTimeline> timeline;
+
+	//state playback last applied to the object
+	FTimelinePlaybackState playbackState;
+
+	//where the object was last filed in the spatial index
+	FTimelineSpatialCursor spatialCursor;
+
+	//radius of the object's bounds when it was last recorded, used to test queries against recorded positions
+	float boundsRadius = 0.0f;
+
+	//id of the object shared by the server and every client, 0 if the object has no stable name to match it by
+	uint32 netId = 0;
+
+	//difference between the server's state and this client's recording when the server last corrected the object during playback
+	//the difference is blended out over time so playback settles back onto the local recording
+	//rotation holds the rotation from the local state to the server's
+	FRewindStruct correction;
+	bool hasCorrection = false;
+
+	//this client had no recorded state to offset, so correction holds the server's state itself until it expires
+	bool isCorrectionAbsolute = false;
+
+	//world time the correction arrived at
+	double correctionWorldTime = 0.0;
+
+	//current generation of this slot, increased each time the slot is recycled
+	int32 generation = 0;
+
+	//index of this slot in the dense list of active slots, INDEX_NONE when free
+	int32 denseIndex = INDEX_NONE;
+};
+
+/**
+ * Dense generational handle table mapping tracked objects to timeline slots.
+ * Handles resolve to slots with array indexing, active slots are packed for iteration
+ * and removed slots are recycled through a free list.
+ */
+class TIMEREWIND_API FTimelineHandleTable
+{
+public:
+	//Add a collision object and create its timeline with the number of positions to record and the layout to store
+	//Timelines are created with the manager's storage settings. Returns the existing handle if the object is already tracked
+	FTimelineHandle Add(UShapeComponent* physicsObj, int numPositions, ETimelineLayout layout, const FTimelineStorageSettings& storage);
+
+	//Remove a slot and recycle it. Returns false if the handle is stale
+	bool Remove(const FTimelineHandle& handle);
+
+	//Remove every slot and invalidate every handle
+	void Reset();
+
+	//Resolve a handle to its slot. Returns nullptr if the handle is stale
+	FTimelineSlot* Get(const FTimelineHandle& handle);
+	const FTimelineSlot* Get(const FTimelineHandle& handle) const;
+
+	//Find the handle for a tracked object. This is a hashed lookup and should be kept off hot paths
+	FTimelineHandle FindHandle(const UShapeComponent* physicsObj) const;
+
+	//Number of active slots
+	int32 Num() const;
+
+	//Get the active slot at a dense index for iteration
+	FTimelineSlot& GetSlotAt(int32 denseIndex);
+	const FTimelineSlot& GetSlotAt(int32 denseIndex) const;
+
+	//Get the handle of the active slot at a dense index
+	FTimelineHandle GetHandleAt(int32 denseIndex) const;
+
+private:
+	//every slot ever created, active or free
+	TArray<FTimelineSlot> slots;
+
+	//slot indices of active slots, packed for iteration
+	TArray<int32> denseSlots;
+
+	//slot indices ready to be recycled
+	TArray<int32> freeSlots;
+
+	//Maps tracked object to slot index for lookups from blueprint
+	TMap<TObjectKey<UShapeComponent>, int32> objectSlotMap;
+};
@@ -0,0 +1,76 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineHandleTable.h"
+#include "Components/BoxComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineHandleGenerationsTest, "TimeRewind.HandleTable.Generations", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Add, remove and recycle slots, checking stale handles stop resolving instead of finding the object that reused their slot
+bool FTimelineHandleGenerationsTest::RunTest(const FString& Parameters)
+{
+	FTimelineArena arena;
+	arena.Init(FTimelineArena::PageSize * 4);
+
+	FTimelineStorageSettings storage;
+	storage.arena = &arena;
+	storage.tickSeconds = 0.06f;
+
+	UBoxComponent* firstBox = NewObject<UBoxComponent>(GetTransientPackage());
+	UBoxComponent* secondBox = NewObject<UBoxComponent>(GetTransientPackage());
+	UBoxComponent* thirdBox = NewObject<UBoxComponent>(GetTransientPackage());
+
+	FTimelineHandleTable timelineTable;
+
+	FTimelineHandle firstHandle = timelineTable.Add(firstBox, 16, ETimelineLayout::Transform, storage);
+	FTimelineHandle secondHandle = timelineTable.Add(secondBox, 16, ETimelineLayout::Transform, storage);
+
+	TestTrue(TEXT("Handles are issued"), firstHandle.IsSet() && secondHandle.IsSet());
+	TestNotEqual(TEXT("Objects get their own slots"), firstHandle.slotIndex, secondHandle.slotIndex);
+	TestEqual(TEXT("Adding a tracked object again returns its handle"), timelineTable.Add(firstBox, 16, ETimelineLayout::Transform, storage), firstHandle);
+	TestEqual(TEXT("Two active slots"), timelineTable.Num(), 2);
+	TestEqual(TEXT("Objects are found by handle"), timelineTable.FindHandle(secondBox), secondHandle);
+
+	//removing a slot makes its handle stale
+	TestTrue(TEXT("Remove succeeds"), timelineTable.Remove(firstHandle));
+	TestFalse(TEXT("Removing twice fails"), timelineTable.Remove(firstHandle));
+	TestNull(TEXT("Removed handle no longer resolves"), timelineTable.Get(firstHandle));
+	TestEqual(TEXT("One active slot"), timelineTable.Num(), 1);
+
+	//the freed slot is recycled under a new generation
+	FTimelineHandle thirdHandle = timelineTable.Add(thirdBox, 16, ETimelineLayout::Transform, storage);
+
+	TestEqual(TEXT("Freed slot is recycled"), thirdHandle.slotIndex, firstHandle.slotIndex);
+	TestEqual(TEXT("Recycled slot has the next generation"), thirdHandle.generation, firstHandle.generation + 1);
+	TestNull(TEXT("Old handle stays stale after its slot is recycled"), timelineTable.Get(firstHandle));
+
+	const FTimelineSlot* thirdSlot = timelineTable.Get(thirdHandle);
+	TestTrue(TEXT("New handle resolves to the new object"), thirdSlot != nullptr && thirdSlot->physicsObj.Get() == thirdBox);
+
+	//every handle resolves through the dense list it was packed into
+	for (int32 denseIndex = 0; denseIndex < timelineTable.Num(); denseIndex++)
+	{
+		TestEqual(FString::Printf(TEXT("Dense index %d round trips"), denseIndex), timelineTable.Get(timelineTable.GetHandleAt(denseIndex)), &timelineTable.GetSlotAt(denseIndex));
+	}
+
+	//resetting invalidates every handle
+	timelineTable.Reset();
+
+	TestEqual(TEXT("No active slots after reset"), timelineTable.Num(), 0);
+	TestNull(TEXT("Handles are stale after reset"), timelineTable.Get(secondHandle));
+	TestNull(TEXT("Recycled handles are stale after reset"), timelineTable.Get(thirdHandle));
+	TestFalse(TEXT("Objects are forgotten after reset"), timelineTable.FindHandle(secondBox).IsSet());
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,199 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineInterpolation.h"
+
+//Lerp a buffer of four float vectors with vector registers
+static void LerpVectorized(const FVector4f* from, const FVector4f* to, FVector4f* out, int32 count, const VectorRegister4Float& alpha)
+{
+	for (int32 index = 0; index < count; index++)
+	{
+		VectorRegister4Float fromValue = VectorLoad(&from[index].X);
+		VectorRegister4Float toValue = VectorLoad(&to[index].X);
+
+		VectorStore(VectorMultiplyAdd(VectorSubtract(toValue, fromValue), alpha, fromValue), &out[index].X);
+	}
+}
+
+//Lerp a buffer of four float vectors one float at a time
+static void LerpScalar(const FVector4f* from, const FVector4f* to, FVector4f* out, int32 count, float alpha)
+{
+	for (int32 index = 0; index < count; index++)
+	{
+		out[index] = from[index] + (to[index] - from[index]) * alpha;
+	}
+}
+
+//Set the state to a recorded position
+void FTimelinePlaybackState::Set(const FRewindStruct& point)
+{
+	position = point.position;
+	rotation = point.rotation.Quaternion();
+	linearVel = point.linearVel;
+	angularVel = point.angularVel;
+	isValid = true;
+}
+
+//Remove every object from the batch
+void FTimelineInterpolator::Reset()
+{
+	fromPositions.Reset();
+	toPositions.Reset();
+	fromRotations.Reset();
+	toRotations.Reset();
+	fromLinearVels.Reset();
+	toLinearVels.Reset();
+	fromAngularVels.Reset();
+	toAngularVels.Reset();
+}
+
+//Number of objects in the batch
+int32 FTimelineInterpolator::Num() const
+{
+	return toPositions.Num();
+}
+
+//Add an object to blend from one state towards another
+int32 FTimelineInterpolator::Add(const FVector& fromPosition, const FQuat& fromRotation, const FVector& fromLinearVel, const FVector& fromAngularVel,
+	const FVector& toPosition, const FQuat& toRotation, const FVector& toLinearVel, const FVector& toAngularVel)
+{
+	fromPositions.Add(FVector4f(FVector3f(fromPosition), 0.0f));
+	fromRotations.Add(FQuat4f(fromRotation));
+	fromLinearVels.Add(FVector4f(FVector3f(fromLinearVel), 0.0f));
+	fromAngularVels.Add(FVector4f(FVector3f(fromAngularVel), 0.0f));
+
+	toRotations.Add(FQuat4f(toRotation));
+	toLinearVels.Add(FVector4f(FVector3f(toLinearVel), 0.0f));
+	toAngularVels.Add(FVector4f(FVector3f(toAngularVel), 0.0f));
+
+	return toPositions.Add(FVector4f(FVector3f(toPosition), 0.0f));
+}
+
+//Blend every object, using vector registers when the platform supports them
+void FTimelineInterpolator::Interpolate(float alpha)
+{
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+	InterpolateVectorized(alpha);
+#else
+	InterpolateScalar(alpha);
+#endif
+}
+
+//Blend every object with vector registers
+void FTimelineInterpolator::InterpolateVectorized(float alpha)
+{
+	int32 count = Num();
+
+	outPositions.SetNumUninitialized(count, false);
+	outRotations.SetNumUninitialized(count, false);
+	outLinearVels.SetNumUninitialized(count, false);
+	outAngularVels.SetNumUninitialized(count, false);
+
+	VectorRegister4Float alphaValue = VectorSetFloat1(alpha);
+
+	LerpVectorized(fromPositions.GetData(), toPositions.GetData(), outPositions.GetData(), count, alphaValue);
+	LerpVectorized(fromLinearVels.GetData(), toLinearVels.GetData(), outLinearVels.GetData(), count, alphaValue);
+	LerpVectorized(fromAngularVels.GetData(), toAngularVels.GetData(), outAngularVels.GetData(), count, alphaValue);
+
+	for (int32 index = 0; index < count; index++)
+	{
+		VectorRegister4Float fromRotation = VectorLoad(&fromRotations[index].X);
+		VectorRegister4Float toRotation = VectorLoad(&toRotations[index].X);
+
+		//flip the target into the same hemisphere so the blend takes the shortest path
+		VectorRegister4Float flipMask = VectorCompareLT(VectorDot4(fromRotation, toRotation), VectorZeroFloat());
+		toRotation = VectorSelect(flipMask, VectorNegate(toRotation), toRotation);
+
+		VectorRegister4Float blendedRotation = VectorMultiplyAdd(VectorSubtract(toRotation, fromRotation), alphaValue, fromRotation);
+		blendedRotation = VectorMultiply(blendedRotation, VectorReciprocalSqrtAccurate(VectorDot4(blendedRotation, blendedRotation)));
+
+		VectorStore(blendedRotation, &outRotations[index].X);
+	}
+}
+
+//Blend every object one float at a time
+void FTimelineInterpolator::InterpolateScalar(float alpha)
+{
+	int32 count = Num();
+
+	outPositions.SetNumUninitialized(count, false);
+	outRotations.SetNumUninitialized(count, false);
+	outLinearVels.SetNumUninitialized(count, false);
+	outAngularVels.SetNumUninitialized(count, false);
+
+	LerpScalar(fromPositions.GetData(), toPositions.GetData(), outPositions.GetData(), count, alpha);
+	LerpScalar(fromLinearVels.GetData(), toLinearVels.GetData(), outLinearVels.GetData(), count, alpha);
+	LerpScalar(fromAngularVels.GetData(), toAngularVels.GetData(), outAngularVels.GetData(), count, alpha);
+
+	for (int32 index = 0; index < count; index++)
+	{
+		const FQuat4f& fromRotation = fromRotations[index];
+		FQuat4f toRotation = toRotations[index];
+
+		//flip the target into the same hemisphere so the blend takes the shortest path
+		if ((fromRotation | toRotation) < 0.0f)
+		{
+			toRotation = toRotation * -1.0f;
+		}
+
+		FQuat4f blendedRotation = fromRotation + (toRotation - fromRotation) * alpha;
+		outRotations[index] = blendedRotation * FMath::InvSqrt(blendedRotation | blendedRotation);
+	}
+}
+
+//Run the vector and scalar paths on the current batch and check every result matches within a tolerance
+bool FTimelineInterpolator::VerifyEquivalence(float alpha, float tolerance)
+{
+	InterpolateVectorized(alpha);
+
+	TArray<FVector4f> vectorPositions = outPositions;
+	TArray<FQuat4f> vectorRotations = outRotations;
+	TArray<FVector4f> vectorLinearVels = outLinearVels;
+	TArray<FVector4f> vectorAngularVels = outAngularVels;
+
+	InterpolateScalar(alpha);
+
+	for (int32 index = 0; index < Num(); index++)
+	{
+		//the sign of a quaternion does not change the rotation it describes
+		bool rotationMatches = vectorRotations[index].Equals(outRotations[index], tolerance) || vectorRotations[index].Equals(outRotations[index] * -1.0f, tolerance);
+
+		if (!rotationMatches || !vectorPositions[index].Equals(outPositions[index], tolerance)
+			|| !vectorLinearVels[index].Equals(outLinearVels[index], tolerance) || !vectorAngularVels[index].Equals(outAngularVels[index], tolerance))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//Get the blended position of an object after interpolating
+FVector FTimelineInterpolator::GetPosition(int32 index) const
+{
+	return FVector(outPositions[index].X, outPositions[index].Y, outPositions[index].Z);
+}
+
+//Get the blended rotation of an object after interpolating
+FQuat FTimelineInterpolator::GetRotation(int32 index) const
+{
+	return FQuat(outRotations[index]);
+}
+
+//Get the blended linear velocity of an object after interpolating
+FVector FTimelineInterpolator::GetLinearVelocity(int32 index) const
+{
+	return FVector(outLinearVels[index].X, outLinearVels[index].Y, outLinearVels[index].Z);
+}
+
+//Get the blended angular velocity of an object after interpolating
+FVector FTimelineInterpolator::GetAngularVelocity(int32 index) const
+{
+	return FVector(outAngularVels[index].X, outAngularVels[index].Y, outAngularVels[index].Z);
+}
@@ -0,0 +1,86 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RewindStruct.h"
+
+/**
+ * State playback last applied to an object, kept so playback never reads it back from the component
+ */
+struct TIMEREWIND_API FTimelinePlaybackState
+{
+	FVector position = FVector::ZeroVector;
+	FQuat rotation = FQuat::Identity;
+	FVector linearVel = FVector::ZeroVector;
+	FVector angularVel = FVector::ZeroVector;
+
+	//false until playback first moves the object
+	bool isValid = false;
+
+	//Set the state to a recorded position
+	void Set(const FRewindStruct& point);
+};
+
+/**
+ * Batch of objects interpolated together during playback.
+ * Each channel is kept in its own contiguous buffer of four floats per object, so one vector register
+ * holds one object's channel and every object is interpolated in a single tight loop.
+ * Rotations are blended as quaternions along the shortest path and renormalized instead of lerping Euler angles.
+ */
+class TIMEREWIND_API FTimelineInterpolator
+{
+public:
+	//Remove every object from the batch, keeping the buffers allocated
+	void Reset();
+
+	//Number of objects in the batch
+	int32 Num() const;
+
+	//Add an object to blend from one state towards another. Returns its index in the batch
+	int32 Add(const FVector& fromPosition, const FQuat& fromRotation, const FVector& fromLinearVel, const FVector& fromAngularVel,
+		const FVector& toPosition, const FQuat& toRotation, const FVector& toLinearVel, const FVector& toAngularVel);
+
+	//Blend every object, using vector registers when the platform supports them
+	void Interpolate(float alpha);
+
+	//Blend every object one float at a time
+	void InterpolateScalar(float alpha);
+
+	//Run the vector and scalar paths on the current batch and check every result matches within a tolerance
+	bool VerifyEquivalence(float alpha, float tolerance = 1.e-4f);
+
+	//Get the blended state of an object after interpolating
+	FVector GetPosition(int32 index) const;
+	FQuat GetRotation(int32 index) const;
+	FVector GetLinearVelocity(int32 index) const;
+	FVector GetAngularVelocity(int32 index) const;
+
+private:
+	//state each object blends from, the state it blends towards and the blended result
+	//vectors are padded to four floats so every channel loads as one vector register
+	TArray<FVector4f> fromPositions;
+	TArray<FVector4f> toPositions;
+	TArray<FVector4f> outPositions;
+
+	TArray<FQuat4f> fromRotations;
+	TArray<FQuat4f> toRotations;
+	TArray<FQuat4f> outRotations;
+
+	TArray<FVector4f> fromLinearVels;
+	TArray<FVector4f> toLinearVels;
+	TArray<FVector4f> outLinearVels;
+
+	TArray<FVector4f> fromAngularVels;
+	TArray<FVector4f> toAngularVels;
+	TArray<FVector4f> outAngularVels;
+
+	//Blend every object with vector registers
+	void InterpolateVectorized(float alpha);
+};
@@ -0,0 +1,80 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineInterpolation.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineInterpolatorEquivalenceTest, "TimeRewind.Interpolation.VectorMatchesScalar", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Blend a fixed batch with the vector and scalar paths at edge alphas and check both agree
+bool FTimelineInterpolatorEquivalenceTest::RunTest(const FString& Parameters)
+{
+	//loose enough for the vector path fusing its multiply and add, tight enough to catch a wrong blend
+	const float tolerance = 1.e-3f;
+
+	FTimelineInterpolator interpolator;
+
+	//an empty batch has nothing to disagree on
+	TestTrue(TEXT("Empty batch matches"), interpolator.VerifyEquivalence(0.5f, tolerance));
+
+	//null points are left at their default zeroed state, so a batch can blend from or to them
+	FRewindStruct nullPoint = FRewindStruct();
+	FQuat nullRotation = nullPoint.rotation.Quaternion();
+
+	//both ends null
+	interpolator.Add(nullPoint.position, nullRotation, nullPoint.linearVel, nullPoint.angularVel,
+		nullPoint.position, nullRotation, nullPoint.linearVel, nullPoint.angularVel);
+
+	//null to a recorded position
+	interpolator.Add(nullPoint.position, nullRotation, nullPoint.linearVel, nullPoint.angularVel,
+		FVector(250.0f, -40.0f, 12.5f), FQuat(FRotator(0.0f, 90.0f, 0.0f)), FVector(100.0f, 0.0f, -980.0f), FVector(0.0f, 0.0f, 3.0f));
+
+	//the same rotation on both ends, where slerp has no angle to divide by
+	FQuat sameRotation = FQuat(FRotator(30.0f, -60.0f, 15.0f));
+	interpolator.Add(FVector(1.0f, 2.0f, 3.0f), sameRotation, FVector::ZeroVector, FVector::ZeroVector,
+		FVector(4.0f, 5.0f, 6.0f), sameRotation, FVector::OneVector, FVector::OneVector);
+
+	//the same rotation stored with opposite signs, which must blend along the shortest path
+	FQuat flipRotation = FQuat(FRotator(-10.0f, 170.0f, 45.0f));
+	interpolator.Add(FVector(-500.0f, 0.0f, 0.0f), flipRotation, FVector(10.0f, 20.0f, 30.0f), FVector(-1.0f, 0.0f, 1.0f),
+		FVector(500.0f, 0.0f, 0.0f), flipRotation * -1.0f, FVector(-10.0f, -20.0f, -30.0f), FVector(1.0f, 0.0f, -1.0f));
+
+	//nearly half a turn apart
+	interpolator.Add(FVector(0.0f, 0.0f, 100.0f), FQuat::Identity, FVector(0.0f, 0.0f, 50.0f), FVector::ZeroVector,
+		FVector(0.0f, 0.0f, -100.0f), FQuat(FVector::UpVector, FMath::DegreesToRadians(179.0f)), FVector(0.0f, 0.0f, -50.0f), FVector(0.0f, 0.0f, 6.0f));
+
+	//a count that is not a multiple of the vector width
+	TestEqual(TEXT("Batch size"), interpolator.Num(), 5);
+
+	const float alphas[] = { 0.0f, KINDA_SMALL_NUMBER, 0.25f, 0.5f, 1.0f - KINDA_SMALL_NUMBER, 1.0f };
+
+	for (float alpha : alphas)
+	{
+		TestTrue(FString::Printf(TEXT("Vector and scalar paths match at alpha %f"), alpha), interpolator.VerifyEquivalence(alpha, tolerance));
+	}
+
+	//the ends of the blend land exactly on the recorded states
+	interpolator.Interpolate(0.0f);
+	TestTrue(TEXT("Alpha 0 is the from position"), interpolator.GetPosition(3).Equals(FVector(-500.0f, 0.0f, 0.0f), tolerance));
+
+	interpolator.Interpolate(1.0f);
+	TestTrue(TEXT("Alpha 1 is the to position"), interpolator.GetPosition(1).Equals(FVector(250.0f, -40.0f, 12.5f), tolerance));
+	TestTrue(TEXT("Alpha 1 is the to rotation"), interpolator.GetRotation(1).Equals(FQuat(FRotator(0.0f, 90.0f, 0.0f)), tolerance)
+		|| interpolator.GetRotation(1).Equals(FQuat(FRotator(0.0f, 90.0f, 0.0f)) * -1.0f, tolerance));
+
+	//blending between opposite signs of one rotation never leaves that rotation
+	interpolator.Interpolate(0.5f);
+	TestTrue(TEXT("Opposite signs blend along the shortest path"), FMath::Abs(interpolator.GetRotation(3) | flipRotation) > 1.0f - tolerance);
+
+	return true;
+}
+
+#endif
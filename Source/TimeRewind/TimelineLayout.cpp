@@ -0,0 +1,55 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineLayout.h"
+#include "TimelineSnapshot.h"
+
+//Check if a timeline index is inside the timeline
+bool FTimeline::IsValidIndex(int timelineIndex) const
+{
+	return timelineIndex >= 0 && timelineIndex < Num();
+}
+
+//Check if this timeline records velocities
+bool FTimeline::HasVelocity() const
+{
+	return (GetChannels() & (ETimelineChannel::LinearVelocity | ETimelineChannel::AngularVelocity)) != 0;
+}
+
+//Pick positions older than the full rate history to thin on a worker thread
+bool FTimeline::PrepareCompaction(int newestIndex, int32 fullRateTicks, int32 halfRateTicks)
+{
+	return false;
+}
+
+//Thin the picked positions
+void FTimeline::Compact()
+{
+}
+
+//Swap the thinned positions in and return the pages they came from
+void FTimeline::FinishCompaction()
+{
+}
+
+//Create an empty timeline for a layout with the manager's storage settings
+TUniquePtr<FTimeline> FTimeline::Create(ETimelineLayout layout, const FTimelineStorageSettings& storage)
+{
+	switch (layout)
+	{
+	case ETimelineLayout::Transform:
+		return MakeUnique<FTransformTimeline>(*storage.arena, storage.denseTicks);
+	case ETimelineLayout::Snapshots:
+		return MakeUnique<FSnapshotTimeline>(storage.snapshotTicks, storage.firstTick, storage.tickSeconds);
+	case ETimelineLayout::Extrapolated:
+		return MakeUnique<FExtrapolatedTimeline>(storage.extrapolationPositionTolerance, storage.extrapolationRotationTolerance, storage.tickSeconds);
+	default:
+		return MakeUnique<FPhysicsTimeline>(*storage.arena, storage.denseTicks);
+	}
+}
@@ -0,0 +1,861 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RewindStruct.h"
+#include "TimelineArena.h"
+#include "Components/ShapeComponent.h"
+#include "TimelineLayout.generated.h"
+
+//Channels a timeline can record. Combine with | to describe a layout
+namespace ETimelineChannel
+{
+	enum Type : uint32
+	{
+		Position = 1 << 0,
+		Rotation = 1 << 1,
+		LinearVelocity = 1 << 2,
+		AngularVelocity = 1 << 3,
+	};
+}
+
+/**
+ * Layout picked for an object when it starts being tracked
+ */
+UENUM(BlueprintType)
+enum class ETimelineLayout : uint8
+{
+	//pick physics for simulating objects and transform for everything else
+	Auto,
+	//position, rotation and both velocities
+	Physics,
+	//position and rotation only, for kinematic movers
+	Transform,
+	//position, rotation and both velocities kept every few seconds and reconstructed in between
+	Snapshots,
+	//position, rotation and both velocities kept only when motion stops following the last kept position
+	Extrapolated
+};
+
+/**
+ * Storage settings shared by every timeline the manager creates
+ */
+struct TIMEREWIND_API FTimelineStorageSettings
+{
+	//arena dense timelines take their pages from
+	FTimelineArena* arena = nullptr;
+
+	//newest ticks dense timelines keep at full rate in their ring of pages, 0 to keep the whole window
+	//older ticks are only kept as thinned history
+	int32 denseTicks = 0;
+
+	//ticks between the positions snapshot timelines keep
+	int32 snapshotTicks = 1;
+
+	//absolute recording tick of timeline index 0 when the timeline is created, so every object's snapshots fall on the same ticks
+	int64 firstTick = 0;
+
+	//drift in distance and radians extrapolated timelines allow before keeping a position
+	float extrapolationPositionTolerance = 1.0f;
+	float extrapolationRotationTolerance = 0.02f;
+
+	//seconds between recorded ticks
+	float tickSeconds = 0.0f;
+};
+
+/**
+ * Recorded positions for one object, independent of the channels it records.
+ * Samples are read and written as FRewindStruct so the rest of the manager does not depend on the layout.
+ */
+class TIMEREWIND_API FTimeline
+{
+public:
+	virtual ~FTimeline() {}
+
+	//Layout this timeline stores
+	virtual ETimelineLayout GetLayout() const = 0;
+
+	//Channels this timeline records
+	virtual uint32 GetChannels() const = 0;
+
+	//Bytes stored for each position
+	virtual int32 GetStride() const = 0;
+
+	//Number of positions in the timeline
+	virtual int32 Num() const = 0;
+
+	//Bytes this timeline holds outside of the arena
+	virtual int64 GetAllocatedBytes() const = 0;
+
+	//Check if a timeline index is inside the timeline
+	bool IsValidIndex(int timelineIndex) const;
+
+	//Resize the timeline and mark every position as null
+	virtual void Init(int numPositions) = 0;
+
+	//Free every position
+	virtual void Reset() = 0;
+
+	//Remove the oldest position and add a null position to the end
+	virtual void Shift() = 0;
+
+	//Read the position at a timeline index. Channels the layout does not record are zero
+	virtual void Read(int timelineIndex, FRewindStruct& outPoint) const = 0;
+
+	//Write a position at a timeline index, keeping only the channels the layout records
+	virtual void Write(int timelineIndex, const FRewindStruct& point) = 0;
+
+	//Read the current state of a collision object, querying only the channels the layout records
+	//Nothing is written, so states can be gathered before the timelines are locked and written afterwards
+	virtual void CaptureState(UShapeComponent* physicsObj, FRewindStruct& outPoint) const = 0;
+
+	//Check if this timeline records velocities and its object should simulate physics outside of playback
+	bool HasVelocity() const;
+
+	//Pick positions older than the full rate history to thin on a worker thread. Returns false if there is nothing to thin
+	//Ages are in ticks behind the timeline index being recorded
+	virtual bool PrepareCompaction(int newestIndex, int32 fullRateTicks, int32 halfRateTicks);
+
+	//Thin the picked positions. Runs on a worker thread and only reads positions the game thread leaves alone until FinishCompaction
+	virtual void Compact();
+
+	//Swap the thinned positions in and return the pages they came from. Runs on the game thread
+	virtual void FinishCompaction();
+
+	//Create an empty timeline for a layout with the manager's storage settings
+	static TUniquePtr<FTimeline> Create(ETimelineLayout layout, const FTimelineStorageSettings& storage);
+};
+
+/**
+ * Timeline storing only the channels in its channel set.
+ * Offsets and stride are compile-time constants and absent channels compile away,
+ * so recording and playback have no per-channel branching.
+ * Positions and velocities are stored in single precision and rotations as float rotators.
+ * Positions live in fixed-size pages taken from the manager's arena. Pages are addressed through a small ring of
+ * page pointers by a tick that only ever increases, so shifting the timeline moves no memory.
+ * Pages are only taken on the first write into them and returned once they slide out of the window.
+ * The ring can cover less than the window. History older than the ring is thinned into records of tick and position,
+ * which are packed into arena pages as well, so a long window costs pages for its thinned history only.
+ * Until an object records a position different from its first one, that position is kept inline and no page is taken,
+ * so objects that never move cost a single position.
+ */
+template<uint32 Channels>
+class TTimeline final : public FTimeline
+{
+public:
+	static constexpr bool HasPosition = (Channels & ETimelineChannel::Position) != 0;
+	static constexpr bool HasRotation = (Channels & ETimelineChannel::Rotation) != 0;
+	static constexpr bool HasLinearVelocity = (Channels & ETimelineChannel::LinearVelocity) != 0;
+	static constexpr bool HasAngularVelocity = (Channels & ETimelineChannel::AngularVelocity) != 0;
+
+	//playback always moves the object, so every layout records its transform
+	static_assert(HasPosition && HasRotation, "Timeline layouts must record position and rotation");
+
+	//byte offset of each channel inside a position
+	static constexpr int32 PositionOffset = 0;
+	static constexpr int32 RotationOffset = PositionOffset + (HasPosition ? sizeof(FVector3f) : 0);
+	static constexpr int32 LinearVelocityOffset = RotationOffset + (HasRotation ? sizeof(FRotator3f) : 0);
+	static constexpr int32 AngularVelocityOffset = LinearVelocityOffset + (HasLinearVelocity ? sizeof(FVector3f) : 0);
+	static constexpr int32 FlagsOffset = AngularVelocityOffset + (HasAngularVelocity ? sizeof(FVector3f) : 0);
+
+	//bytes stored for each position
+	static constexpr int32 Stride = FlagsOffset + sizeof(uint8);
+
+	//bits of the flags byte
+	static constexpr uint8 ResetFlag = 1 << 0;
+	static constexpr uint8 NullFlag = 1 << 1;
+	static constexpr uint8 SoundFlag = 1 << 2;
+
+	//positions stored in each arena page
+	static constexpr int32 PointsPerPage = FTimelineArena::PageSize / Stride;
+	static_assert(PointsPerPage > 0, "Timeline layout does not fit in an arena page");
+
+	//bytes stored for each thinned position, its tick followed by the position
+	static constexpr int32 AgedStride = sizeof(int64) + Stride;
+
+	//thinned positions stored in each arena page
+	static constexpr int32 AgedPointsPerPage = FTimelineArena::PageSize / AgedStride;
+	static_assert(AgedPointsPerPage > 0, "Thinned timeline layout does not fit in an arena page");
+
+	TTimeline(FTimelineArena& newArena, int32 newDenseTicks)
+		: arena(&newArena)
+		, denseTicks(FMath::Max(newDenseTicks, 0))
+	{
+	}
+
+	virtual ~TTimeline()
+	{
+		Reset();
+	}
+
+	virtual ETimelineLayout GetLayout() const override
+	{
+		return HasLinearVelocity ? ETimelineLayout::Physics : ETimelineLayout::Transform;
+	}
+
+	virtual uint32 GetChannels() const override
+	{
+		return Channels;
+	}
+
+	virtual int32 GetStride() const override
+	{
+		return Stride;
+	}
+
+	virtual int32 Num() const override
+	{
+		return numPoints;
+	}
+
+	virtual int64 GetAllocatedBytes() const override
+	{
+		return pages.GetAllocatedSize() + pageNumbers.GetAllocatedSize() + agedPages.GetAllocatedSize() + compactedPages.GetAllocatedSize();
+	}
+
+	virtual void Init(int numPositions) override
+	{
+		Reset();
+
+		numPoints = FMath::Max(numPositions, 0);
+		arenaResetCount = arena->GetResetCount();
+
+		//nothing is stored until the first write
+		isResting = true;
+		restStartTick = 0;
+		restEndTick = 0;
+	}
+
+	virtual void Reset() override
+	{
+		//pages from before an arena reset were already returned with every other page
+		if (arena->GetResetCount() == arenaResetCount)
+		{
+			for (uint8* page : pages)
+			{
+				arena->FreePage(page);
+			}
+
+			for (uint8* agedPage : agedPages)
+			{
+				arena->FreePage(agedPage);
+			}
+
+			for (uint8* compactedPage : compactedPages)
+			{
+				arena->FreePage(compactedPage);
+			}
+		}
+
+		pages.Empty();
+		pageNumbers.Empty();
+		numPoints = 0;
+		firstTick = 0;
+		isResting = true;
+		restStartTick = 0;
+		restEndTick = 0;
+		agedPages.Empty();
+		numAgedPoints = 0;
+		agedEndTick = 0;
+		compactedPages.Empty();
+		numCompactedPoints = 0;
+	}
+
+	virtual void Shift() override
+	{
+		if (numPoints == 0)
+		{
+			return;
+		}
+
+		//moving the first tick forward drops the oldest position
+		int64 droppedTick = firstTick;
+		firstTick++;
+
+		//return the page once its last position leaves the window, new positions read as null until written
+		if (pages.Num() > 0 && droppedTick % PointsPerPage == PointsPerPage - 1)
+		{
+			FreeDensePage(droppedTick / PointsPerPage);
+		}
+		//thinned history is returned a page at a time once a later thinned position is before the window
+		//the newest position before the window is kept to rebuild the first positions from
+		if (agedPages.Num() > 1 && GetAgedTick(agedPages, AgedPointsPerPage) <= firstTick)
+		{
+			arena->FreePage(agedPages[0]);
+			agedPages.RemoveAt(0, 1, false);
+			numAgedPoints -= AgedPointsPerPage;
+		}
+	}
+
+	virtual void Read(int timelineIndex, FRewindStruct& outPoint) const override
+	{
+		int64 tick = firstTick + timelineIndex;
+
+		//thinned history is rebuilt from the positions kept around it
+		if (tick < agedEndTick)
+		{
+			ReadAged(tick, outPoint);
+			return;
+		}
+
+		const uint8* point = FindPoint(tick);
+
+		//positions without a page were never stored and read as null
+		if (point == nullptr)
+		{
+			outPoint = FRewindStruct();
+			return;
+		}
+
+		Decode(point, outPoint);
+	}
+
+	virtual void Write(int timelineIndex, const FRewindStruct& point) override
+	{
+		//encode the whole position first so it can be compared with the resting position
+		uint8 outPoint[Stride];
+
+		Store(outPoint + PositionOffset, FVector3f(point.position));
+		Store(outPoint + RotationOffset, FRotator3f(point.rotation));
+
+		if constexpr (HasLinearVelocity)
+		{
+			Store(outPoint + LinearVelocityOffset, FVector3f(point.linearVel));
+		}
+
+		if constexpr (HasAngularVelocity)
+		{
+			Store(outPoint + AngularVelocityOffset, FVector3f(point.angularVel));
+		}
+
+		outPoint[FlagsOffset] = (point.resetPosition ? ResetFlag : 0) | (point.isNull ? NullFlag : 0) | (point.playSound ? SoundFlag : 0);
+
+		StorePoint(firstTick + timelineIndex, outPoint);
+	}
+
+	virtual void CaptureState(UShapeComponent* physicsObj, FRewindStruct& outPoint) const override
+	{
+		//automated positions are valid, not resets and play no sound
+		outPoint = FRewindStruct();
+		outPoint.isNull = false;
+		outPoint.resetPosition = false;
+		outPoint.playSound = false;
+
+		outPoint.position = physicsObj->GetComponentLocation();
+		outPoint.rotation = physicsObj->GetComponentRotation();
+
+		//only query the physics state this layout stores
+		if constexpr (HasLinearVelocity)
+		{
+			outPoint.linearVel = physicsObj->GetPhysicsLinearVelocity();
+		}
+
+		if constexpr (HasAngularVelocity)
+		{
+			outPoint.angularVel = physicsObj->GetPhysicsAngularVelocityInRadians();
+		}
+	}
+
+	virtual bool PrepareCompaction(int newestIndex, int32 fullRateTicks, int32 halfRateTicks) override
+	{
+		//resting timelines hold a single position and have nothing to thin
+		if (isResting || pages.Num() == 0)
+		{
+			return false;
+		}
+
+		//only whole pages past the full rate history are thinned, so each one can be returned once it is done
+		int64 newestTick = firstTick + newestIndex;
+		int64 newAgedEndTick = ((newestTick - fullRateTicks) / PointsPerPage) * PointsPerPage;
+
+		if (newAgedEndTick <= FMath::Max(agedEndTick, firstTick))
+		{
+			return false;
+		}
+
+		compactionStartTick = FMath::Max(agedEndTick, firstTick);
+		compactionEndTick = newAgedEndTick;
+		compactionQuarterRateTick = newestTick - halfRateTicks;
+		compactionFirstTick = firstTick;
+
+		//the arena is only used on the game thread, so take enough pages for every position the worker could keep
+		int64 maxCompactedPoints = numAgedPoints + (compactionEndTick - compactionStartTick);
+		int32 numCompactedPages = int32(FMath::DivideAndRoundUp<int64>(maxCompactedPoints, AgedPointsPerPage));
+
+		for (int32 pageIndex = 0; pageIndex < numCompactedPages; pageIndex++)
+		{
+			compactedPages.Add(arena->AllocatePage());
+		}
+
+		numCompactedPoints = 0;
+
+		return true;
+	}
+
+	virtual void Compact() override
+	{
+		numCompactedPoints = 0;
+
+		//keep events and every position changing between null and valid, and thin the rest by age
+		//full rate history is never thinned here, older history is kept at half rate and the oldest at quarter rate
+		bool wasNull = true;
+
+		auto KeepPoint = [&](int64 tick, const uint8* point)
+		{
+			uint8 flags = point[FlagsOffset];
+			bool isNull = (flags & NullFlag) != 0;
+			int64 rate = tick < compactionQuarterRateTick ? 4 : 2;
+
+			if ((flags & (ResetFlag | SoundFlag)) != 0 || isNull != wasNull || tick % rate == 0)
+			{
+				//positions before the window are dropped, keeping the newest one to rebuild the first positions from
+				bool isExpired = numCompactedPoints > 0 && tick <= compactionFirstTick
+					&& GetAgedTick(compactedPages, numCompactedPoints - 1) <= compactionFirstTick;
+
+				SetAgedPoint(compactedPages, isExpired ? numCompactedPoints - 1 : numCompactedPoints, tick, point);
+				numCompactedPoints += isExpired ? 0 : 1;
+			}
+
+			wasNull = isNull;
+		};
+
+		//history thinned by earlier passes is thinned again as it ages past the quarter rate boundary
+		for (int32 agedIndex = 0; agedIndex < numAgedPoints; agedIndex++)
+		{
+			KeepPoint(GetAgedTick(agedPages, agedIndex), GetAgedPoint(agedPages, agedIndex));
+		}
+
+		//missing pages were never written and are kept as null
+		uint8 nullPoint[Stride] = {};
+		nullPoint[FlagsOffset] = NullFlag;
+
+		for (int64 tick = compactionStartTick; tick < compactionEndTick; tick++)
+		{
+			const uint8* point = FindPoint(tick);
+			KeepPoint(tick, point != nullptr ? point : nullPoint);
+		}
+	}
+
+	virtual void FinishCompaction() override
+	{
+		//return every page that is now fully thinned
+		for (int64 pageNumber = compactionStartTick / PointsPerPage; pageNumber < compactionEndTick / PointsPerPage; pageNumber++)
+		{
+			FreeDensePage(pageNumber);
+		}
+
+		//the earlier thinned history was copied into the new pages
+		for (uint8* agedPage : agedPages)
+		{
+			arena->FreePage(agedPage);
+		}
+
+		//return the pages taken for positions the worker did not keep
+		int32 numUsedPages = FMath::DivideAndRoundUp(numCompactedPoints, AgedPointsPerPage);
+
+		for (int32 pageIndex = numUsedPages; pageIndex < compactedPages.Num(); pageIndex++)
+		{
+			arena->FreePage(compactedPages[pageIndex]);
+		}
+
+		compactedPages.SetNum(numUsedPages, false);
+
+		agedPages = MoveTemp(compactedPages);
+		numAgedPoints = numCompactedPoints;
+		agedEndTick = compactionEndTick;
+
+		compactedPages.Reset();
+		numCompactedPoints = 0;
+	}
+
+private:
+	//Decode the position at a tick from thinned history
+	void ReadAged(int64 tick, FRewindStruct& outPoint) const
+	{
+		int32 nextIndex = FindNextAgedIndex(tick);
+
+		if (nextIndex == 0)
+		{
+			outPoint = FRewindStruct();
+			return;
+		}
+
+		int64 prevTick = GetAgedTick(agedPages, nextIndex - 1);
+		Decode(GetAgedPoint(agedPages, nextIndex - 1), outPoint);
+
+		if (prevTick == tick)
+		{
+			return;
+		}
+
+		//the position after the last thinned one is the first position still in pages
+		bool hasNextAged = nextIndex < numAgedPoints;
+		int64 nextTick = hasNextAged ? GetAgedTick(agedPages, nextIndex) : agedEndTick;
+		const uint8* nextPoint = hasNextAged ? GetAgedPoint(agedPages, nextIndex) : FindPoint(agedEndTick);
+
+		//events only happen on their own tick
+		outPoint.resetPosition = false;
+		outPoint.playSound = false;
+
+		//null stretches and anything leading into a teleport hold the earlier position
+		if (nextPoint == nullptr || outPoint.isNull || (nextPoint[FlagsOffset] & (NullFlag | ResetFlag)) != 0)
+		{
+			return;
+		}
+
+		FRewindStruct nextStruct;
+		Decode(nextPoint, nextStruct);
+
+		float alpha = float(tick - prevTick) / float(nextTick - prevTick);
+
+		outPoint.position = FMath::Lerp(outPoint.position, nextStruct.position, alpha);
+		outPoint.rotation = FQuat::Slerp(outPoint.rotation.Quaternion(), nextStruct.rotation.Quaternion(), alpha).Rotator();
+		outPoint.linearVel = FMath::Lerp(outPoint.linearVel, nextStruct.linearVel, alpha);
+		outPoint.angularVel = FMath::Lerp(outPoint.angularVel, nextStruct.angularVel, alpha);
+	}
+
+	//Decode a stored position
+	static void Decode(const uint8* point, FRewindStruct& outPoint)
+	{
+		outPoint.position = FVector(Load<FVector3f>(point + PositionOffset));
+		outPoint.rotation = FRotator(Load<FRotator3f>(point + RotationOffset));
+
+		if constexpr (HasLinearVelocity)
+		{
+			outPoint.linearVel = FVector(Load<FVector3f>(point + LinearVelocityOffset));
+		}
+		else
+		{
+			outPoint.linearVel = FVector::ZeroVector;
+		}
+
+		if constexpr (HasAngularVelocity)
+		{
+			outPoint.angularVel = FVector(Load<FVector3f>(point + AngularVelocityOffset));
+		}
+		else
+		{
+			outPoint.angularVel = FVector::ZeroVector;
+		}
+
+		uint8 flags = point[FlagsOffset];
+		outPoint.resetPosition = (flags & ResetFlag) != 0;
+		outPoint.isNull = (flags & NullFlag) != 0;
+		outPoint.playSound = (flags & SoundFlag) != 0;
+	}
+
+	//arena the pages are taken from
+	FTimelineArena* arena = nullptr;
+
+	//reset count of the arena when the pages were taken
+	uint32 arenaResetCount = 0;
+
+	//newest ticks kept in the ring of pages, 0 to cover the whole window
+	int32 denseTicks = 0;
+
+	//ring of pages covering the newest history, Stride bytes per position packed one after another inside each page
+	//empty until the first page is needed
+	TArray<uint8*> pages;
+
+	//page number each ring entry holds, a page number being the tick of its first position divided by PointsPerPage
+	TArray<int64> pageNumbers;
+
+	//number of positions in the timeline
+	int32 numPoints = 0;
+
+	//tick of timeline index 0, increased by one each shift
+	int64 firstTick = 0;
+
+	//true while every write has matched the first one, so the position is kept inline instead of in pages
+	bool isResting = true;
+
+	//range of ticks holding the resting position
+	int64 restStartTick = 0;
+	int64 restEndTick = 0;
+
+	//position shared by every tick in the resting range
+	uint8 restPoint[Stride];
+
+	//positions kept from history older than the ring once its pages were returned, sorted by tick
+	//packed AgedStride bytes each into arena pages, ticks before agedEndTick are rebuilt from these instead of read from pages
+	TArray<uint8*> agedPages;
+	int32 numAgedPoints = 0;
+	int64 agedEndTick = 0;
+
+	//thinned history built on a worker thread into pages taken beforehand, swapped in by FinishCompaction
+	TArray<uint8*> compactedPages;
+	int32 numCompactedPoints = 0;
+
+	//range of ticks being thinned, the tick older history drops to quarter rate at and the first tick of the window
+	int64 compactionStartTick = 0;
+	int64 compactionEndTick = 0;
+	int64 compactionQuarterRateTick = 0;
+	int64 compactionFirstTick = 0;
+
+	//Get the tick of a thinned position
+	static int64 GetAgedTick(const TArray<uint8*>& fromPages, int32 agedIndex)
+	{
+		return Load<int64>(fromPages[agedIndex / AgedPointsPerPage] + (agedIndex % AgedPointsPerPage) * AgedStride);
+	}
+
+	//Get the bytes of a thinned position
+	static const uint8* GetAgedPoint(const TArray<uint8*>& fromPages, int32 agedIndex)
+	{
+		return fromPages[agedIndex / AgedPointsPerPage] + (agedIndex % AgedPointsPerPage) * AgedStride + sizeof(int64);
+	}
+
+	//Store a thinned position in pages already taken
+	static void SetAgedPoint(const TArray<uint8*>& toPages, int32 agedIndex, int64 tick, const uint8* point)
+	{
+		uint8* agedPoint = toPages[agedIndex / AgedPointsPerPage] + (agedIndex % AgedPointsPerPage) * AgedStride;
+		Store(agedPoint, tick);
+		FMemory::Memcpy(agedPoint + sizeof(int64), point, Stride);
+	}
+
+	//Add a thinned position after every other one, taking a page when the last one is full
+	void AppendAgedPoint(int64 tick, const uint8* point)
+	{
+		if (numAgedPoints == agedPages.Num() * AgedPointsPerPage)
+		{
+			agedPages.Add(arena->AllocatePage());
+		}
+
+		SetAgedPoint(agedPages, numAgedPoints, tick, point);
+		numAgedPoints++;
+	}
+
+	//Find the index of the first thinned position after a tick
+	int32 FindNextAgedIndex(int64 tick) const
+	{
+		int32 lowIndex = 0;
+		int32 highIndex = numAgedPoints;
+
+		while (lowIndex < highIndex)
+		{
+			int32 midIndex = lowIndex + (highIndex - lowIndex) / 2;
+
+			if (GetAgedTick(agedPages, midIndex) <= tick)
+			{
+				lowIndex = midIndex + 1;
+			}
+			else
+			{
+				highIndex = midIndex;
+			}
+		}
+
+		return lowIndex;
+	}
+
+	//Find the bytes of the position at a tick. Returns nullptr if it was never stored
+	const uint8* FindPoint(int64 tick) const
+	{
+		if (isResting)
+		{
+			return tick >= restStartTick && tick < restEndTick ? restPoint : nullptr;
+		}
+
+		if (pages.Num() == 0)
+		{
+			return nullptr;
+		}
+
+		int64 pageNumber = tick / PointsPerPage;
+		int32 ringIndex = int32(pageNumber % pages.Num());
+
+		//the ring entry may hold a different page mapped to the same place
+		const uint8* page = pageNumbers[ringIndex] == pageNumber ? pages[ringIndex] : nullptr;
+
+		return page != nullptr ? page + (tick % PointsPerPage) * Stride : nullptr;
+	}
+
+	//Return the page holding a page number to the arena if the ring still has it
+	void FreeDensePage(int64 pageNumber)
+	{
+		int32 ringIndex = int32(pageNumber % pages.Num());
+
+		if (pages[ringIndex] != nullptr && pageNumbers[ringIndex] == pageNumber)
+		{
+			arena->FreePage(pages[ringIndex]);
+			pages[ringIndex] = nullptr;
+			pageNumbers[ringIndex] = INDEX_NONE;
+		}
+	}
+
+	//Move every position before a page aligned tick out of the ring and into thinned history
+	//Unchanged stretches keep their first and last position, so reading them back gives the same positions
+	void SpillToAged(int64 endTick)
+	{
+		uint8 nullPoint[Stride] = {};
+		nullPoint[FlagsOffset] = NullFlag;
+
+		const uint8* prevPoint = nullptr;
+		bool isPrevKept = false;
+
+		for (int64 tick = FMath::Max(agedEndTick, firstTick); tick < endTick; tick++)
+		{
+			const uint8* point = FindPoint(tick);
+			point = point != nullptr ? point : nullPoint;
+
+			bool isChanged = prevPoint == nullptr || FMemory::Memcmp(point, prevPoint, Stride) != 0;
+
+			//close the unchanged stretch before a change with its last position
+			if (isChanged && prevPoint != nullptr && !isPrevKept)
+			{
+				AppendAgedPoint(tick - 1, prevPoint);
+			}
+
+			if (isChanged)
+			{
+				AppendAgedPoint(tick, point);
+			}
+
+			prevPoint = point;
+			isPrevKept = isChanged;
+		}
+
+		if (prevPoint != nullptr && !isPrevKept)
+		{
+			AppendAgedPoint(endTick - 1, prevPoint);
+		}
+
+		agedEndTick = FMath::Max(agedEndTick, endTick);
+
+		//every page before the end tick is now held as thinned history
+		for (int32 ringIndex = 0; ringIndex < pages.Num(); ringIndex++)
+		{
+			if (pages[ringIndex] != nullptr && pageNumbers[ringIndex] < endTick / PointsPerPage)
+			{
+				arena->FreePage(pages[ringIndex]);
+				pages[ringIndex] = nullptr;
+				pageNumbers[ringIndex] = INDEX_NONE;
+			}
+		}
+	}
+
+	//Get the bytes of the position at a tick, taking its page from the arena on first use
+	uint8* AllocatePoint(int64 tick)
+	{
+		//the window can straddle one more page than it fills, and a thinned ring also holds the page compaction
+		//has not reached yet and the one it is a pass behind on, so pages are only spilled if compaction falls behind
+		if (pages.Num() == 0)
+		{
+			int32 ringTicks = denseTicks > 0 ? FMath::Min(denseTicks, numPoints) : numPoints;
+			pages.SetNumZeroed(FMath::DivideAndRoundUp(ringTicks, PointsPerPage) + (ringTicks < numPoints ? 3 : 1));
+			pageNumbers.Init(INDEX_NONE, pages.Num());
+		}
+
+		int64 pageNumber = tick / PointsPerPage;
+		int32 ringIndex = int32(pageNumber % pages.Num());
+
+		if (pages[ringIndex] != nullptr && pageNumbers[ringIndex] != pageNumber)
+		{
+			//an older page still in the window is thinned before its place is reused
+			if (pageNumbers[ringIndex] < pageNumber)
+			{
+				SpillToAged((pageNumbers[ringIndex] + 1) * PointsPerPage);
+			}
+			//a newer page is left over from before a resume further back and is no longer valid
+			else
+			{
+				FreeDensePage(pageNumbers[ringIndex]);
+			}
+		}
+
+		uint8*& page = pages[ringIndex];
+
+		if (page == nullptr)
+		{
+			page = arena->AllocatePage();
+			pageNumbers[ringIndex] = pageNumber;
+
+			//positions in a new page are null until written
+			for (int32 pointIndex = 0; pointIndex < PointsPerPage; pointIndex++)
+			{
+				uint8* point = page + pointIndex * Stride;
+				FMemory::Memzero(point, Stride);
+				point[FlagsOffset] = NullFlag;
+			}
+		}
+
+		return page + (tick % PointsPerPage) * Stride;
+	}
+
+	//Store an encoded position at a tick
+	void StorePoint(int64 tick, const uint8* encodedPoint)
+	{
+		//writing into thinned history, such as when resuming from far back, discards it from there on
+		if (tick < agedEndTick)
+		{
+			numAgedPoints = FindNextAgedIndex(tick - 1);
+
+			int32 numUsedPages = FMath::DivideAndRoundUp(numAgedPoints, AgedPointsPerPage);
+
+			for (int32 pageIndex = numUsedPages; pageIndex < agedPages.Num(); pageIndex++)
+			{
+				arena->FreePage(agedPages[pageIndex]);
+			}
+
+			agedPages.SetNum(numUsedPages, false);
+			agedEndTick = tick;
+		}
+
+		if (isResting)
+		{
+			//the first write starts the resting range
+			if (restStartTick == restEndTick)
+			{
+				FMemory::Memcpy(restPoint, encodedPoint, Stride);
+				restStartTick = tick;
+				restEndTick = tick + 1;
+				return;
+			}
+
+			//the same position written inside or right after the range extends it
+			if (tick >= restStartTick && tick <= restEndTick && FMemory::Memcmp(restPoint, encodedPoint, Stride) == 0)
+			{
+				restEndTick = FMath::Max(restEndTick, tick + 1);
+				return;
+			}
+
+			//the object changed, copy the resting range still in the window into pages and store normally from now on
+			//resting ranges longer than the ring are thinned as they are copied
+			isResting = false;
+
+			for (int64 restTick = FMath::Max(restStartTick, firstTick); restTick < restEndTick; restTick++)
+			{
+				FMemory::Memcpy(AllocatePoint(restTick), restPoint, Stride);
+			}
+		}
+
+		FMemory::Memcpy(AllocatePoint(tick), encodedPoint, Stride);
+	}
+
+	//channels are packed without padding, so they are copied in and out instead of read in place
+	template<typename ValueType>
+	static ValueType Load(const uint8* source)
+	{
+		ValueType value;
+		FMemory::Memcpy(&value, source, sizeof(ValueType));
+		return value;
+	}
+
+	template<typename ValueType>
+	static void Store(uint8* dest, const ValueType& value)
+	{
+		FMemory::Memcpy(dest, &value, sizeof(ValueType));
+	}
+};
+
+//Layout for simulating physics objects
+typedef TTimeline<ETimelineChannel::Position | ETimelineChannel::Rotation | ETimelineChannel::LinearVelocity | ETimelineChannel::AngularVelocity> FPhysicsTimeline;
+
+//Layout for kinematic movers
+typedef TTimeline<ETimelineChannel::Position | ETimelineChannel::Rotation> FTransformTimeline;
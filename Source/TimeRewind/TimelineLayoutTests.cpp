@@ -0,0 +1,166 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineLayout.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+//Position recorded at a tick: steady motion along x, a teleport, and a stretch where the object is absent
+static FRewindStruct MakeTestPoint(int32 tick, int32 resetTick, int32 nullStartTick, int32 nullEndTick)
+{
+	FRewindStruct point = FRewindStruct();
+	point.isNull = tick >= nullStartTick && tick < nullEndTick;
+	point.resetPosition = tick == resetTick;
+	point.playSound = false;
+
+	if (point.isNull)
+	{
+		return point;
+	}
+
+	//the teleport moves the object far away and it carries on from there
+	float offset = tick >= resetTick ? -5000.0f : 0.0f;
+
+	point.position = FVector(tick * 10.0f + offset, 0.0f, 100.0f);
+	point.rotation = FRotator(0.0f, tick * 0.5f, 0.0f);
+	point.linearVel = FVector(10.0f / 0.06f, 0.0f, 0.0f);
+	point.angularVel = FVector::ZeroVector;
+
+	return point;
+}
+
+//Check a position read back from a timeline against the one written
+static bool IsNearlyTestPoint(const FRewindStruct& readPoint, const FRewindStruct& writtenPoint, float tolerance)
+{
+	if (readPoint.isNull != writtenPoint.isNull)
+	{
+		return false;
+	}
+
+	return readPoint.isNull || (readPoint.position.Equals(writtenPoint.position, tolerance) && readPoint.rotation.Equals(writtenPoint.rotation, tolerance));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineCompactionTest, "TimeRewind.Layout.Compaction", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Thin old history the way the manager does and check it reads back the same, with events exact and fewer pages held
+bool FTimelineCompactionTest::RunTest(const FString& Parameters)
+{
+	const int32 numPositions = 400;
+	const int32 resetTick = 100;
+	const int32 nullStartTick = 200;
+	const int32 nullEndTick = 220;
+	const float tolerance = 0.01f;
+
+	FTimelineArena arena;
+	arena.Init(FTimelineArena::PageSize * 64);
+
+	FTimelineStorageSettings storage;
+	storage.arena = &arena;
+	storage.tickSeconds = 0.06f;
+
+	TUniquePtr<FTimeline> timeline = FTimeline::Create(ETimelineLayout::Physics, storage);
+	timeline->Init(numPositions);
+
+	for (int32 tick = 0; tick < numPositions; tick++)
+	{
+		timeline->Write(tick, MakeTestPoint(tick, resetTick, nullStartTick, nullEndTick));
+	}
+
+	int64 usedBytesBefore = arena.GetUsedBytes();
+
+	//thin everything older than the newest 50 ticks, at quarter rate past the newest 150
+	TestTrue(TEXT("Old pages are picked for thinning"), timeline->PrepareCompaction(numPositions - 1, 50, 150));
+	timeline->Compact();
+	timeline->FinishCompaction();
+
+	TestTrue(TEXT("Thinning returns pages"), arena.GetUsedBytes() < usedBytesBefore);
+	TestFalse(TEXT("Nothing is left to thin"), timeline->PrepareCompaction(numPositions - 1, 50, 150));
+
+	for (int32 tick = 0; tick < numPositions; tick++)
+	{
+		FRewindStruct writtenPoint = MakeTestPoint(tick, resetTick, nullStartTick, nullEndTick);
+		FRewindStruct readPoint;
+		timeline->Read(tick, readPoint);
+
+		//the ticks leading into the teleport and the absent stretch hold the last kept position rather than blend across the jump
+		if ((tick > resetTick - 4 && tick < resetTick) || (tick > nullStartTick - 4 && tick < nullStartTick))
+		{
+			continue;
+		}
+
+		TestTrue(FString::Printf(TEXT("Tick %d reads back"), tick), IsNearlyTestPoint(readPoint, writtenPoint, tolerance));
+	}
+
+	FRewindStruct resetPoint;
+	timeline->Read(resetTick, resetPoint);
+	TestTrue(TEXT("Teleport is kept as a reset"), resetPoint.resetPosition);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineDenseRingTest, "TimeRewind.Layout.DenseRing", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Record a window several times longer than the ring of pages without compacting and check nothing is lost
+bool FTimelineDenseRingTest::RunTest(const FString& Parameters)
+{
+	const int32 numPositions = 1000;
+	const int32 resetTick = 300;
+	const int32 nullStartTick = 600;
+	const int32 nullEndTick = 650;
+	const float tolerance = 0.01f;
+
+	FTimelineArena arena;
+	arena.Init(FTimelineArena::PageSize * 64);
+
+	FTimelineStorageSettings storage;
+	storage.arena = &arena;
+	storage.tickSeconds = 0.06f;
+	storage.denseTicks = 50;
+
+	TUniquePtr<FTimeline> timeline = FTimeline::Create(ETimelineLayout::Physics, storage);
+	timeline->Init(numPositions);
+
+	//the object rests for a while first, so leaving the resting position spills a long range at once
+	FRewindStruct restPoint = MakeTestPoint(0, resetTick, nullStartTick, nullEndTick);
+
+	for (int32 tick = 0; tick < numPositions; tick++)
+	{
+		timeline->Write(tick, tick < 100 ? restPoint : MakeTestPoint(tick, resetTick, nullStartTick, nullEndTick));
+	}
+
+	for (int32 tick = 0; tick < numPositions; tick++)
+	{
+		FRewindStruct writtenPoint = tick < 100 ? restPoint : MakeTestPoint(tick, resetTick, nullStartTick, nullEndTick);
+		FRewindStruct readPoint;
+		timeline->Read(tick, readPoint);
+
+		TestTrue(FString::Printf(TEXT("Tick %d reads back"), tick), IsNearlyTestPoint(readPoint, writtenPoint, tolerance));
+	}
+
+	//history older than the ring is packed into arena pages rather than taken from the heap
+	TestTrue(TEXT("Spilled history lives in the arena"), arena.GetUsedBytes() > 0 && arena.GetOverflowBytes() == 0);
+
+	//resuming from far back discards everything after the resume tick
+	FRewindStruct resumePoint = MakeTestPoint(150, resetTick, nullStartTick, nullEndTick);
+	resumePoint.position.Z = 500.0f;
+	timeline->Write(150, resumePoint);
+
+	FRewindStruct readResume;
+	timeline->Read(150, readResume);
+	TestTrue(TEXT("Resumed position reads back"), IsNearlyTestPoint(readResume, resumePoint, tolerance));
+
+	FRewindStruct readBefore;
+	timeline->Read(149, readBefore);
+	TestTrue(TEXT("Position before the resume is kept"), IsNearlyTestPoint(readBefore, MakeTestPoint(149, resetTick, nullStartTick, nullEndTick), tolerance));
+
+	return true;
+}
+
+#endif
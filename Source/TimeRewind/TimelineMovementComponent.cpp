@@ -0,0 +1,233 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+
+//Start recording input with a checkpoint every number of ticks
+void UTimelineMovementComponent::StartRecording(int32 checkpointTicks)
+{
+	inputTimeline.Init(checkpointTicks);
+	isRecording = true;
+	isReplaying = false;
+}
+
+//Stop recording and replaying, dropping any recorded input
+void UTimelineMovementComponent::StopRecording()
+{
+	inputTimeline.Reset();
+	isRecording = false;
+	isReplaying = false;
+	hasPendingFire = false;
+}
+
+//Mark the start of an absolute recording tick, taking a checkpoint when one is due
+void UTimelineMovementComponent::MarkTick(int64 tick)
+{
+	if (!isRecording || CharacterOwner == nullptr || UpdatedComponent == nullptr)
+	{
+		return;
+	}
+
+	if (inputTimeline.NeedsCheckpoint(tick))
+	{
+		FCharacterCheckpoint checkpoint;
+		CaptureCheckpoint(checkpoint);
+		inputTimeline.MarkTick(tick, &checkpoint);
+	}
+	else
+	{
+		inputTimeline.MarkTick(tick, nullptr);
+	}
+}
+
+//Drop recorded input no longer needed to rebuild an absolute tick or anything after it
+void UTimelineMovementComponent::PruneBefore(int64 tick)
+{
+	inputTimeline.PruneBefore(tick);
+}
+
+//Drop recorded input from an absolute tick on, such as an abandoned future after resuming
+void UTimelineMovementComponent::TruncateFrom(int64 tick)
+{
+	inputTimeline.TruncateFrom(tick);
+}
+
+//Flag the current frame as firing
+void UTimelineMovementComponent::RecordFire()
+{
+	hasPendingFire = isRecording;
+}
+
+//Switch between recording live movement and being moved by replayed input
+void UTimelineMovementComponent::SetReplaying(bool shouldReplay)
+{
+	isReplaying = shouldReplay;
+	isRecording = !shouldReplay;
+	hasPendingFire = false;
+
+	//the character may have moved since the last replay, so the next one starts from a checkpoint
+	replayTick = INDEX_NONE;
+	replayCheckpointTick = INDEX_NONE;
+}
+
+//Move the character to where it was at an absolute tick by replaying its recorded input
+void UTimelineMovementComponent::ReplayTo(int64 tick)
+{
+	//only the authority moves characters, clients are corrected by normal movement replication
+	if (!isReplaying || tick == replayTick || CharacterOwner == nullptr || UpdatedComponent == nullptr || CharacterOwner->GetLocalRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	const FCharacterCheckpoint* checkpoint = inputTimeline.FindCheckpoint(tick);
+	int64 tickOffset = inputTimeline.GetTickOffset(tick);
+
+	if (checkpoint == nullptr || tickOffset == INDEX_NONE)
+	{
+		return;
+	}
+
+	//seeking backwards or past the next checkpoint starts again from the checkpoint before the tick
+	if (checkpoint->tick != replayCheckpointTick || tick < replayTick)
+	{
+		ApplyCheckpoint(*checkpoint);
+
+		replayCheckpointTick = checkpoint->tick;
+		replayOffset = checkpoint->byteOffset;
+		replayFrame = FCharacterInputFrame();
+	}
+
+	//replay every frame up to the start of the tick
+	while (replayOffset < tickOffset)
+	{
+		replayOffset = inputTimeline.ReadFrame(replayOffset, replayFrame);
+		ApplyFrame(replayFrame);
+	}
+
+	replayTick = tick;
+}
+
+//Get the bytes held by the recorded input
+int64 UTimelineMovementComponent::GetInputBytes() const
+{
+	return inputTimeline.GetAllocatedBytes();
+}
+
+//Record the input a locally controlled character is about to consume this frame
+void UTimelineMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	//only locally controlled characters move from pending input here
+	//the server records remote players from the moves their clients send, simulated proxies are moved by replication
+	if (isRecording && CharacterOwner != nullptr && CharacterOwner->IsLocallyControlled())
+	{
+		FCharacterInputFrame frame;
+		frame.deltaTime = DeltaTime;
+		frame.inputVector = GetPendingInputVector();
+		frame.controlRotation = CharacterOwner->GetControlRotation();
+		frame.hasRequestedVelocity = bHasRequestedVelocity;
+		frame.requestedVelocity = RequestedVelocity;
+		frame.wantsJump = CharacterOwner->bPressedJump;
+		frame.fired = hasPendingFire;
+
+		inputTimeline.RecordFrame(frame);
+		hasPendingFire = false;
+	}
+
+	//the rest of the tick still runs while replaying, PerformMovement skips the live move
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+//Record each move the server receives from a remote player's client before running it
+void UTimelineMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	if (isRecording && CharacterOwner != nullptr && !CharacterOwner->IsLocallyControlled())
+	{
+		//clients send the acceleration their input produced, scaling it back down replays it as the same input
+		float maxAcceleration = GetMaxAcceleration();
+
+		FCharacterInputFrame frame;
+		frame.deltaTime = DeltaTime;
+		frame.inputVector = maxAcceleration > KINDA_SMALL_NUMBER ? NewAccel / maxAcceleration : FVector::ZeroVector;
+		frame.controlRotation = CharacterOwner->GetControlRotation();
+		frame.wantsJump = (CompressedFlags & FSavedMove_Character::FLAG_JumpPressed) != 0;
+		frame.fired = hasPendingFire;
+
+		inputTimeline.RecordFrame(frame);
+		hasPendingFire = false;
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+//Skip live movement while replaying, only replayed frames move the character
+void UTimelineMovementComponent::PerformMovement(float DeltaTime)
+{
+	if (isReplaying && !isApplyingFrame)
+	{
+		return;
+	}
+
+	Super::PerformMovement(DeltaTime);
+}
+
+//Store the current movement state
+void UTimelineMovementComponent::CaptureCheckpoint(FCharacterCheckpoint& outCheckpoint) const
+{
+	outCheckpoint.location = UpdatedComponent->GetComponentLocation();
+	outCheckpoint.rotation = UpdatedComponent->GetComponentRotation();
+	outCheckpoint.controlRotation = CharacterOwner->GetControlRotation();
+	outCheckpoint.velocity = Velocity;
+	outCheckpoint.movementMode = uint8(MovementMode.GetValue());
+	outCheckpoint.customMovementMode = CustomMovementMode;
+}
+
+//Move the character to a stored movement state
+void UTimelineMovementComponent::ApplyCheckpoint(const FCharacterCheckpoint& checkpoint)
+{
+	UpdatedComponent->SetWorldLocationAndRotation(checkpoint.location, checkpoint.rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	Velocity = checkpoint.velocity;
+	SetMovementMode(EMovementMode(checkpoint.movementMode), checkpoint.customMovementMode);
+
+	if (AController* controller = CharacterOwner->GetController())
+	{
+		controller->SetControlRotation(checkpoint.controlRotation);
+	}
+}
+
+//Run one recorded frame through the movement code
+void UTimelineMovementComponent::ApplyFrame(const FCharacterInputFrame& frame)
+{
+	//turn the same way the controller turned the character before it moved
+	if (AController* controller = CharacterOwner->GetController())
+	{
+		controller->SetControlRotation(frame.controlRotation);
+	}
+
+	CharacterOwner->FaceRotation(frame.controlRotation, frame.deltaTime);
+
+	//path following requests are consumed by the move like movement input
+	bHasRequestedVelocity = frame.hasRequestedVelocity;
+	RequestedVelocity = frame.requestedVelocity;
+
+	CharacterOwner->bPressedJump = frame.wantsJump;
+
+	isApplyingFrame = true;
+	ControlledCharacterMove(frame.inputVector, frame.deltaTime);
+	isApplyingFrame = false;
+
+	CharacterOwner->ClearJumpInput(frame.deltaTime);
+	bHasRequestedVelocity = false;
+
+	if (frame.fired)
+	{
+		OnReplayedFire.Broadcast();
+	}
+}
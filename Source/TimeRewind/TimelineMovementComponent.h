@@ -0,0 +1,105 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CharacterInputTimeline.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "TimelineMovementComponent.generated.h"
+
+//Broadcast when a replayed frame of input fired
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnReplayedFire);
+
+/**
+ * Character movement that records the input it consumes each frame instead of the character's transforms.
+ * Playback restores the checkpoint before a tick and runs the recorded frames through the same movement code
+ * the character moved with, so rewinding a character costs a few bytes per frame.
+ * Character movement is not bit for bit deterministic and stored inputs are rounded, so replays can drift
+ * slightly between checkpoints. Checkpoints every few ticks keep the drift from building up.
+ */
+UCLASS(ClassGroup = (Custom))
+class TIMEREWIND_API UTimelineMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	//Broadcast when a replayed frame of input fired, such as to play the fire animation during playback
+	//Exposed to blueprint for use in subclasses
+	UPROPERTY(BlueprintAssignable, Category = "Playback")
+	FOnReplayedFire OnReplayedFire;
+
+	//Start recording input with a checkpoint every number of ticks
+	void StartRecording(int32 checkpointTicks);
+
+	//Stop recording and replaying, dropping any recorded input
+	void StopRecording();
+
+	//Mark the start of an absolute recording tick, taking a checkpoint when one is due
+	void MarkTick(int64 tick);
+
+	//Drop recorded input no longer needed to rebuild an absolute tick or anything after it
+	void PruneBefore(int64 tick);
+
+	//Drop recorded input from an absolute tick on, such as an abandoned future after resuming
+	void TruncateFrom(int64 tick);
+
+	//Flag the current frame as firing
+	void RecordFire();
+
+	//Switch between recording live movement and being moved by replayed input
+	void SetReplaying(bool shouldReplay);
+
+	//Move the character to where it was at an absolute tick by replaying its recorded input
+	void ReplayTo(int64 tick);
+
+	//Get the bytes held by the recorded input
+	int64 GetInputBytes() const;
+
+	//Record the input a locally controlled character is about to consume this frame
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	//Record each move the server receives from a remote player's client before running it
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	//Skip live movement while replaying, only replayed frames move the character
+	virtual void PerformMovement(float DeltaTime) override;
+
+private:
+	//input stream and checkpoints of this character
+	FCharacterInputTimeline inputTimeline;
+
+	//is live input being recorded
+	bool isRecording = false;
+
+	//is the character being moved by replayed input
+	bool isReplaying = false;
+
+	//is a replayed frame running through the movement code right now
+	bool isApplyingFrame = false;
+
+	//did the character fire since the last recorded frame
+	bool hasPendingFire = false;
+
+	//last tick replayed, the checkpoint it was replayed from and where the next frame to replay starts
+	//replaying forward inside one checkpoint continues from here instead of starting over
+	int64 replayTick = INDEX_NONE;
+	int64 replayCheckpointTick = INDEX_NONE;
+	int64 replayOffset = 0;
+	FCharacterInputFrame replayFrame;
+
+	//Store the current movement state
+	void CaptureCheckpoint(FCharacterCheckpoint& outCheckpoint) const;
+
+	//Move the character to a stored movement state
+	void ApplyCheckpoint(const FCharacterCheckpoint& checkpoint);
+
+	//Run one recorded frame through the movement code
+	void ApplyFrame(const FCharacterInputFrame& frame);
+};
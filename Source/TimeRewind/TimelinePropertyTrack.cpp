@@ -0,0 +1,179 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelinePropertyTrack.h"
+
+//Create a reflected property track for a value type once the property has been resolved
+template<typename ValueType>
+static TUniquePtr<FTimelineTrack> MakePropertyTrack(UObject* targetObj, FProperty* property, int numPositions)
+{
+	TTimelinePropertySource<ValueType> source;
+	source.targetObj = targetObj;
+	source.valueOffset = property->GetOffset_ForInternal();
+
+	return MakeUnique<TTimelineTrack<ValueType, TTimelinePropertySource<ValueType>>>(source, numPositions);
+}
+
+UObject* FTimelineBoolPropertySource::GetTarget() const
+{
+	return targetObj.Get();
+}
+
+bool FTimelineBoolPropertySource::Read(UObject* target) const
+{
+	return (*(reinterpret_cast<const uint8*>(target) + byteOffset) & fieldMask) != 0;
+}
+
+void FTimelineBoolPropertySource::Write(UObject* target, bool newValue) const
+{
+	uint8* byteValue = reinterpret_cast<uint8*>(target) + byteOffset;
+	*byteValue = newValue ? (*byteValue | fieldMask) : (*byteValue & ~fieldMask);
+}
+
+UObject* FTimelineMaterialScalarSource::GetTarget() const
+{
+	return material.Get();
+}
+
+float FTimelineMaterialScalarSource::Read(UObject* target) const
+{
+	float value = 0.0f;
+	static_cast<UMaterialInstanceDynamic*>(target)->GetScalarParameterValue(parameterInfo, value);
+	return value;
+}
+
+void FTimelineMaterialScalarSource::Write(UObject* target, float newValue) const
+{
+	static_cast<UMaterialInstanceDynamic*>(target)->SetScalarParameterValueByInfo(parameterInfo, newValue);
+}
+
+UObject* FTimelineLightIntensitySource::GetTarget() const
+{
+	return light.Get();
+}
+
+float FTimelineLightIntensitySource::Read(UObject* target) const
+{
+	return static_cast<ULightComponent*>(target)->Intensity;
+}
+
+void FTimelineLightIntensitySource::Write(UObject* target, float newValue) const
+{
+	//go through the setter so the render state is updated
+	static_cast<ULightComponent*>(target)->SetIntensity(newValue);
+}
+
+//Create a track for a property found by name
+TUniquePtr<FTimelineTrack> FTimelineTrack::CreatePropertyTrack(UObject* targetObj, FName propertyName, int numPositions)
+{
+	if (targetObj == nullptr)
+	{
+		return nullptr;
+	}
+
+	//this is the only reflection lookup, every recorded position after this uses the resolved offset
+	FProperty* property = FindFProperty<FProperty>(targetObj->GetClass(), propertyName);
+
+	if (property == nullptr)
+	{
+		return nullptr;
+	}
+
+	//pick the value type from the property type
+	if (property->IsA<FFloatProperty>())
+	{
+		return MakePropertyTrack<float>(targetObj, property, numPositions);
+	}
+
+	if (property->IsA<FDoubleProperty>())
+	{
+		return MakePropertyTrack<double>(targetObj, property, numPositions);
+	}
+
+	if (property->IsA<FIntProperty>())
+	{
+		return MakePropertyTrack<int32>(targetObj, property, numPositions);
+	}
+
+	if (property->IsA<FByteProperty>())
+	{
+		return MakePropertyTrack<uint8>(targetObj, property, numPositions);
+	}
+
+	//enum classes are recorded through their underlying byte
+	if (FEnumProperty* enumProperty = CastField<FEnumProperty>(property))
+	{
+		if (enumProperty->GetUnderlyingProperty()->IsA<FByteProperty>())
+		{
+			return MakePropertyTrack<uint8>(targetObj, property, numPositions);
+		}
+
+		return nullptr;
+	}
+
+	if (FBoolProperty* boolProperty = CastField<FBoolProperty>(property))
+	{
+		FTimelineBoolPropertySource source;
+		source.targetObj = targetObj;
+		source.byteOffset = boolProperty->GetOffset_ForInternal() + boolProperty->GetByteOffset();
+		source.fieldMask = boolProperty->GetFieldMask();
+
+		return MakeUnique<TTimelineTrack<bool, FTimelineBoolPropertySource>>(source, numPositions);
+	}
+
+	if (FStructProperty* structProperty = CastField<FStructProperty>(property))
+	{
+		if (structProperty->Struct == TBaseStructure<FVector>::Get())
+		{
+			return MakePropertyTrack<FVector>(targetObj, property, numPositions);
+		}
+
+		if (structProperty->Struct == TBaseStructure<FRotator>::Get())
+		{
+			return MakePropertyTrack<FRotator>(targetObj, property, numPositions);
+		}
+
+		if (structProperty->Struct == TBaseStructure<FLinearColor>::Get())
+		{
+			return MakePropertyTrack<FLinearColor>(targetObj, property, numPositions);
+		}
+	}
+
+	//property type cannot be recorded
+	return nullptr;
+}
+
+//Create a track for a scalar parameter on a dynamic material instance
+TUniquePtr<FTimelineTrack> FTimelineTrack::CreateMaterialScalarTrack(UMaterialInstanceDynamic* material, FName parameterName, int numPositions)
+{
+	if (material == nullptr)
+	{
+		return nullptr;
+	}
+
+	FTimelineMaterialScalarSource source;
+	source.material = material;
+	source.parameterInfo = FMaterialParameterInfo(parameterName);
+
+	return MakeUnique<TTimelineTrack<float, FTimelineMaterialScalarSource>>(source, numPositions);
+}
+
+//Create a track for the intensity of a light
+TUniquePtr<FTimelineTrack> FTimelineTrack::CreateLightIntensityTrack(ULightComponent* light, int numPositions)
+{
+	if (light == nullptr)
+	{
+		return nullptr;
+	}
+
+	FTimelineLightIntensitySource source;
+	source.light = light;
+
+	return MakeUnique<TTimelineTrack<float, FTimelineLightIntensitySource>>(source, numPositions);
+}
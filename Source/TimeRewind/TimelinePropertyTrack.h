@@ -0,0 +1,236 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "Components/LightComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+/**
+ * Codec for values recorded by a property track.
+ * Specialized per value type at compile time so playback blends values without any reflection lookups.
+ * Blend moves the current value towards the recorded value the same way physics objects are interpolated in playback.
+ */
+template<typename ValueType>
+struct TTimelineTrackCodec
+{
+	//Blend from the current value towards a recorded value
+	static ValueType Blend(const ValueType& currValue, const ValueType& recordedValue, float alpha)
+	{
+		return FMath::Lerp(currValue, recordedValue, alpha);
+	}
+};
+
+//bools are switch states and cannot be blended, so snap to the recorded state
+template<>
+struct TTimelineTrackCodec<bool>
+{
+	static bool Blend(bool currValue, bool recordedValue, float alpha)
+	{
+		return recordedValue;
+	}
+};
+
+//bytes are enum states and cannot be blended, so snap to the recorded state
+template<>
+struct TTimelineTrackCodec<uint8>
+{
+	static uint8 Blend(uint8 currValue, uint8 recordedValue, float alpha)
+	{
+		return recordedValue;
+	}
+};
+
+//ints are usually counters or states, so snap to the recorded value
+template<>
+struct TTimelineTrackCodec<int32>
+{
+	static int32 Blend(int32 currValue, int32 recordedValue, float alpha)
+	{
+		return recordedValue;
+	}
+};
+
+/**
+ * Source for a reflected property. The property is found by name once at registration
+ * and only its memory offset is kept, so reading and writing is a pointer offset.
+ */
+template<typename ValueType>
+struct TTimelinePropertySource
+{
+	//object that owns the property
+	TWeakObjectPtr<UObject> targetObj;
+	//offset of the property value inside the object
+	int32 valueOffset = 0;
+
+	UObject* GetTarget() const
+	{
+		return targetObj.Get();
+	}
+
+	ValueType Read(UObject* target) const
+	{
+		return *reinterpret_cast<const ValueType*>(reinterpret_cast<const uint8*>(target) + valueOffset);
+	}
+
+	void Write(UObject* target, const ValueType& newValue) const
+	{
+		*reinterpret_cast<ValueType*>(reinterpret_cast<uint8*>(target) + valueOffset) = newValue;
+	}
+};
+
+/**
+ * Source for a reflected bool property. Bools may be packed into bitfields,
+ * so the byte offset and bit mask are kept instead of a plain offset.
+ */
+struct TIMEREWIND_API FTimelineBoolPropertySource
+{
+	//object that owns the property
+	TWeakObjectPtr<UObject> targetObj;
+	//offset of the byte holding the bool inside the object
+	int32 byteOffset = 0;
+	//mask of the bits holding the bool inside that byte
+	uint8 fieldMask = 0xFF;
+
+	UObject* GetTarget() const;
+	bool Read(UObject* target) const;
+	void Write(UObject* target, bool newValue) const;
+};
+
+/**
+ * Source for a scalar parameter on a dynamic material instance
+ */
+struct TIMEREWIND_API FTimelineMaterialScalarSource
+{
+	//material instance that owns the parameter
+	TWeakObjectPtr<UMaterialInstanceDynamic> material;
+	//parameter recorded on the material
+	FMaterialParameterInfo parameterInfo;
+
+	UObject* GetTarget() const;
+	float Read(UObject* target) const;
+	void Write(UObject* target, float newValue) const;
+};
+
+/**
+ * Source for the intensity of a light
+ */
+struct TIMEREWIND_API FTimelineLightIntensitySource
+{
+	//light that is recorded
+	TWeakObjectPtr<ULightComponent> light;
+
+	UObject* GetTarget() const;
+	float Read(UObject* target) const;
+	void Write(UObject* target, float newValue) const;
+};
+
+/**
+ * Base for property tracks recorded alongside the physics timelines.
+ * Each track keeps one value per timeline position and shifts with the timelines.
+ */
+class TIMEREWIND_API FTimelineTrack
+{
+public:
+	virtual ~FTimelineTrack() {}
+
+	//key of the object the track was registered on, used to remove every track of an object
+	TObjectKey<UObject> ownerKey;
+
+	//absolute recording tick of the first position this track recorded
+	//positions before this were recorded before the track existed
+	int64 firstRecordedTick = 0;
+
+	//Get the object the track records, nullptr once it is destroyed
+	virtual UObject* GetTarget() const = 0;
+
+	//Record the current value into a timeline position
+	virtual void Capture(int timelineIndex) = 0;
+
+	//Blend the current value towards the value recorded at a timeline position
+	virtual void Apply(int timelineIndex, float alpha) = 0;
+
+	//Remove the oldest position and add a new one to the end
+	virtual void Shift() = 0;
+
+	//Create a track for a float, double, int, byte, enum, bool, vector, rotator or color property found by name
+	//Returns nullptr if the property does not exist or its type cannot be recorded
+	static TUniquePtr<FTimelineTrack> CreatePropertyTrack(UObject* targetObj, FName propertyName, int numPositions);
+
+	//Create a track for a scalar parameter on a dynamic material instance
+	static TUniquePtr<FTimelineTrack> CreateMaterialScalarTrack(UMaterialInstanceDynamic* material, FName parameterName, int numPositions);
+
+	//Create a track for the intensity of a light
+	static TUniquePtr<FTimelineTrack> CreateLightIntensityTrack(ULightComponent* light, int numPositions);
+};
+
+/**
+ * Property track for one value type and source.
+ * The value type picks the codec and the source picks how values are read and written,
+ * so each combination compiles to direct reads, writes and blends.
+ */
+template<typename ValueType, typename SourceType>
+class TTimelineTrack : public FTimelineTrack
+{
+public:
+	TTimelineTrack(const SourceType& newSource, int numPositions)
+		: source(newSource)
+	{
+		values.SetNumZeroed(FMath::Max(numPositions, 0));
+	}
+
+	virtual UObject* GetTarget() const override
+	{
+		return source.GetTarget();
+	}
+
+	virtual void Capture(int timelineIndex) override
+	{
+		UObject* target = source.GetTarget();
+
+		if (target != nullptr && values.IsValidIndex(timelineIndex))
+		{
+			values[timelineIndex] = source.Read(target);
+		}
+	}
+
+	virtual void Apply(int timelineIndex, float alpha) override
+	{
+		UObject* target = source.GetTarget();
+
+		if (target == nullptr || !values.IsValidIndex(timelineIndex))
+		{
+			return;
+		}
+
+		ValueType currValue = source.Read(target);
+		ValueType newValue = TTimelineTrackCodec<ValueType>::Blend(currValue, values[timelineIndex], alpha);
+
+		//skip writes that change nothing so sources with side effects are not triggered every frame
+		if (!(newValue == currValue))
+		{
+			source.Write(target, newValue);
+		}
+	}
+
+	virtual void Shift() override
+	{
+		values.RemoveAt(0, 1, false);
+		values.AddZeroed();
+	}
+
+private:
+	//where values are read from and written to
+	SourceType source;
+
+	//recorded value at each timeline position
+	TArray<ValueType> values;
+};
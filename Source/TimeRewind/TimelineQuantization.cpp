@@ -0,0 +1,37 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineQuantization.h"
+
+//Quantize a normalized rotation
+FQuantizedRotation FQuantizedRotation::Quantize(const FQuat4f& rotation)
+{
+	//q and -q are the same rotation, so keep w positive to use the full range
+	FQuat4f normalized = rotation.GetNormalized();
+
+	if (normalized.W < 0.0f)
+	{
+		normalized = FQuat4f(-normalized.X, -normalized.Y, -normalized.Z, -normalized.W);
+	}
+
+	FQuantizedRotation quantized;
+	quantized.x = int16(FMath::RoundToInt(normalized.X * MAX_int16));
+	quantized.y = int16(FMath::RoundToInt(normalized.Y * MAX_int16));
+	quantized.z = int16(FMath::RoundToInt(normalized.Z * MAX_int16));
+	quantized.w = int16(FMath::RoundToInt(normalized.W * MAX_int16));
+
+	return quantized;
+}
+
+//Restore a normalized rotation
+FQuat4f FQuantizedRotation::Dequantize() const
+{
+	const float scale = 1.0f / MAX_int16;
+	return FQuat4f(x * scale, y * scale, z * scale, w * scale).GetNormalized();
+}
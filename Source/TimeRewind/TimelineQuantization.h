@@ -6,29 +6,34 @@
 //
 //THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
-
 #pragma once
 
 #include "CoreMinimal.h"
-#include "RewindStruct.h"
-#include "TimeArrayStruct.generated.h"
+#include "Math/Float16.h"
 
 /**
- *
+ * Rotation quantized to 16 bits per quaternion component
  */
-USTRUCT(BlueprintType)
-struct TIMEREWIND_API FTimeArrayStruct
+struct TIMEREWIND_API FQuantizedRotation
 {
-	GENERATED_USTRUCT_BODY()
+	int16 x = 0;
+	int16 y = 0;
+	int16 z = 0;
+	int16 w = MAX_int16;
 
-	//Array of timeline points exposed to blueprint for use in child classes
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	TArray<FRewindStruct> TimePoints;
+	//Quantize a normalized rotation
+	static FQuantizedRotation Quantize(const FQuat4f& rotation);
 
-	//default constuctor
-	FTimeArrayStruct();
+	//Restore a normalized rotation
+	FQuat4f Dequantize() const;
+};
 
-	//constructor with desired number of positions based on time recorded
-	//This allows the timeline size to be adjusted based on how long you want to record
-	FTimeArrayStruct(int numPositions);
+/**
+ * Small offset stored as half floats, such as a body offset from its root body
+ */
+struct TIMEREWIND_API FQuantizedOffset
+{
+	FFloat16 x;
+	FFloat16 y;
+	FFloat16 z;
 };
@@ -0,0 +1,62 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineQuantization.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineQuantizationRoundTripTest, "TimeRewind.Quantization.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Quantize rotations and offsets the way the timelines store them and check they come back within their precision
+bool FTimelineQuantizationRoundTripTest::RunTest(const FString& Parameters)
+{
+	//rotations spread over every axis, including ones stored with a negative w
+	FRandomStream randomStream(1234);
+
+	for (int32 rotationIndex = 0; rotationIndex < 256; rotationIndex++)
+	{
+		FRotator rotation(randomStream.FRandRange(-90.0f, 90.0f), randomStream.FRandRange(-180.0f, 180.0f), randomStream.FRandRange(-180.0f, 180.0f));
+		FQuat4f quat = FQuat4f(rotation.Quaternion());
+
+		if (rotationIndex % 2 == 1)
+		{
+			quat = FQuat4f(-quat.X, -quat.Y, -quat.Z, -quat.W);
+		}
+
+		FQuat4f restored = FQuantizedRotation::Quantize(quat).Dequantize();
+
+		//q and -q are the same rotation, so compare the angle between them
+		TestTrue(FString::Printf(TEXT("Rotation %d round trips"), rotationIndex), FMath::Abs(quat | restored) > 1.0f - 1e-4f);
+		TestTrue(FString::Printf(TEXT("Rotation %d is normalized"), rotationIndex), restored.IsNormalized());
+	}
+
+	//the identity is stored without drifting
+	FQuantizedRotation identity = FQuantizedRotation::Quantize(FQuat4f::Identity);
+	TestTrue(TEXT("Identity round trips"), identity.Dequantize().Equals(FQuat4f::Identity, KINDA_SMALL_NUMBER));
+
+	//body offsets are small, and half floats keep them to a fraction of a unit
+	for (int32 offsetIndex = 0; offsetIndex < 256; offsetIndex++)
+	{
+		FVector3f offset(randomStream.FRandRange(-100.0f, 100.0f), randomStream.FRandRange(-100.0f, 100.0f), randomStream.FRandRange(-100.0f, 100.0f));
+
+		FQuantizedOffset quantized;
+		quantized.x = offset.X;
+		quantized.y = offset.Y;
+		quantized.z = offset.Z;
+
+		FVector3f restored(quantized.x.GetFloat(), quantized.y.GetFloat(), quantized.z.GetFloat());
+
+		TestTrue(FString::Printf(TEXT("Offset %d round trips"), offsetIndex), restored.Equals(offset, 0.05f));
+	}
+
+	return true;
+}
+
+#endif
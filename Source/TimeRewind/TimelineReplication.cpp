@@ -0,0 +1,202 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineReplication.h"
+
+//Write a signed value with small magnitudes in few bytes
+static void WriteSignedPacked(FBitWriter& writer, int32 value)
+{
+	//zigzag so small negative values are small too
+	uint32 zigzag = (uint32(value) << 1) ^ uint32(value >> 31);
+	writer.SerializeIntPacked(zigzag);
+}
+
+//Read a signed value written with WriteSignedPacked
+static int32 ReadSignedPacked(FBitReader& reader)
+{
+	uint32 zigzag = 0;
+	reader.SerializeIntPacked(zigzag);
+
+	return int32(zigzag >> 1) ^ -int32(zigzag & 1);
+}
+
+//Write a vector as the difference from a baseline
+static void WriteVectorDelta(FBitWriter& writer, const FIntVector& value, const FIntVector& baseline)
+{
+	WriteSignedPacked(writer, value.X - baseline.X);
+	WriteSignedPacked(writer, value.Y - baseline.Y);
+	WriteSignedPacked(writer, value.Z - baseline.Z);
+}
+
+//Read a vector written as the difference from a baseline
+static FIntVector ReadVectorDelta(FBitReader& reader, const FIntVector& baseline)
+{
+	FIntVector value;
+	value.X = baseline.X + ReadSignedPacked(reader);
+	value.Y = baseline.Y + ReadSignedPacked(reader);
+	value.Z = baseline.Z + ReadSignedPacked(reader);
+
+	return value;
+}
+
+//Quantize a vector to a number of steps of a precision
+static FIntVector QuantizeVector(const FVector& value, float precision)
+{
+	return FIntVector(FMath::RoundToInt(value.X / precision), FMath::RoundToInt(value.Y / precision), FMath::RoundToInt(value.Z / precision));
+}
+
+//Quantize a recorded state
+FTimelineNetState FTimelineNetState::Quantize(const FRewindStruct& point, float positionPrecision, float velocityPrecision)
+{
+	FTimelineNetState state;
+	state.isNull = point.isNull;
+
+	//absent objects have nothing else worth sending
+	if (point.isNull)
+	{
+		return state;
+	}
+
+	state.position = QuantizeVector(point.position, positionPrecision);
+	state.rotation = FQuantizedRotation::Quantize(FQuat4f(point.rotation.Quaternion()));
+	state.linearVel = QuantizeVector(point.linearVel, velocityPrecision);
+	state.angularVel = QuantizeVector(point.angularVel, AngularVelocityPrecision);
+
+	return state;
+}
+
+//Restore a recorded state
+void FTimelineNetState::Dequantize(float positionPrecision, float velocityPrecision, FRewindStruct& outPoint) const
+{
+	outPoint = FRewindStruct();
+	outPoint.isNull = isNull;
+
+	if (isNull)
+	{
+		return;
+	}
+
+	outPoint.position = FVector(position) * positionPrecision;
+	outPoint.rotation = FRotator(FQuat(rotation.Dequantize()));
+	outPoint.linearVel = FVector(linearVel) * velocityPrecision;
+	outPoint.angularVel = FVector(angularVel) * AngularVelocityPrecision;
+}
+
+//Write only the parts of this state that differ from a baseline
+void FTimelineNetState::WriteDelta(FBitWriter& writer, const FTimelineNetState& baseline) const
+{
+	//one bit for null and one per part that changed
+	bool hasPosition = !isNull && position != baseline.position;
+	bool hasRotation = !isNull && (rotation.x != baseline.rotation.x || rotation.y != baseline.rotation.y || rotation.z != baseline.rotation.z || rotation.w != baseline.rotation.w);
+	bool hasLinearVel = !isNull && linearVel != baseline.linearVel;
+	bool hasAngularVel = !isNull && angularVel != baseline.angularVel;
+
+	writer.WriteBit(isNull);
+	writer.WriteBit(hasPosition);
+	writer.WriteBit(hasRotation);
+	writer.WriteBit(hasLinearVel);
+	writer.WriteBit(hasAngularVel);
+
+	if (hasPosition)
+	{
+		WriteVectorDelta(writer, position, baseline.position);
+	}
+
+	if (hasRotation)
+	{
+		WriteSignedPacked(writer, rotation.x - baseline.rotation.x);
+		WriteSignedPacked(writer, rotation.y - baseline.rotation.y);
+		WriteSignedPacked(writer, rotation.z - baseline.rotation.z);
+		WriteSignedPacked(writer, rotation.w - baseline.rotation.w);
+	}
+
+	if (hasLinearVel)
+	{
+		WriteVectorDelta(writer, linearVel, baseline.linearVel);
+	}
+
+	if (hasAngularVel)
+	{
+		WriteVectorDelta(writer, angularVel, baseline.angularVel);
+	}
+}
+
+//Read a state written as the difference from a baseline
+void FTimelineNetState::ReadDelta(FBitReader& reader, const FTimelineNetState& baseline)
+{
+	*this = baseline;
+
+	isNull = reader.ReadBit() != 0;
+	bool hasPosition = reader.ReadBit() != 0;
+	bool hasRotation = reader.ReadBit() != 0;
+	bool hasLinearVel = reader.ReadBit() != 0;
+	bool hasAngularVel = reader.ReadBit() != 0;
+
+	//the sender quantizes absent objects with every part zeroed and keeps that as its baseline, so this side must too
+	if (isNull)
+	{
+		*this = FTimelineNetState();
+	}
+
+	if (hasPosition)
+	{
+		position = ReadVectorDelta(reader, baseline.position);
+	}
+
+	if (hasRotation)
+	{
+		rotation.x = int16(baseline.rotation.x + ReadSignedPacked(reader));
+		rotation.y = int16(baseline.rotation.y + ReadSignedPacked(reader));
+		rotation.z = int16(baseline.rotation.z + ReadSignedPacked(reader));
+		rotation.w = int16(baseline.rotation.w + ReadSignedPacked(reader));
+	}
+
+	if (hasLinearVel)
+	{
+		linearVel = ReadVectorDelta(reader, baseline.linearVel);
+	}
+
+	if (hasAngularVel)
+	{
+		angularVel = ReadVectorDelta(reader, baseline.angularVel);
+	}
+}
+
+//Are two recorded states close enough that the difference between them is not worth correcting
+bool FTimelineNetState::IsNearlyEqual(const FRewindStruct& first, const FRewindStruct& second, float positionTolerance, float rotationTolerance, float speedTolerance)
+{
+	//an object appearing or disappearing is always worth correcting
+	if (first.isNull || second.isNull)
+	{
+		return first.isNull == second.isNull;
+	}
+
+	float angleDegrees = FMath::RadiansToDegrees(first.rotation.Quaternion().AngularDistance(second.rotation.Quaternion()));
+
+	return FVector::Dist(first.position, second.position) <= positionTolerance
+		&& angleDegrees <= rotationTolerance
+		&& FVector::Dist(first.linearVel, second.linearVel) <= speedTolerance;
+}
+
+bool FTimelineNetState::operator==(const FTimelineNetState& other) const
+{
+	//absent objects match whatever their other values were
+	if (isNull || other.isNull)
+	{
+		return isNull == other.isNull;
+	}
+
+	return position == other.position && linearVel == other.linearVel && angularVel == other.angularVel
+		&& rotation.x == other.rotation.x && rotation.y == other.rotation.y && rotation.z == other.rotation.z && rotation.w == other.rotation.w;
+}
+
+bool FTimelineNetState::operator!=(const FTimelineNetState& other) const
+{
+	return !(*this == other);
+}
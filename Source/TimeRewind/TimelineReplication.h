@@ -0,0 +1,115 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RewindStruct.h"
+#include "TimelineQuantization.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "UObject/NoExportTypes.h"
+#include "TimelineReplication.generated.h"
+
+/**
+ * Playback state the server replicates so every client plays back the same moment
+ */
+USTRUCT()
+struct TIMEREWIND_API FTimelineNetPlayback
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	bool isInPlayback = false; //is the server in playback mode
+
+	UPROPERTY()
+	bool isPlaybackPaused = false; //is the server's playback paused
+
+	UPROPERTY()
+	double playbackWorldTime = 0.0; //server world time the position being played back was recorded at
+};
+
+/**
+ * Recorded state of one object quantized for sending to clients.
+ * States are sent as the difference from the last state sent for the object, so objects barely moving cost a few bytes.
+ */
+struct TIMEREWIND_API FTimelineNetState
+{
+	//radians per second of each quantization step of the angular velocity
+	static constexpr float AngularVelocityPrecision = 0.01f;
+
+	//quantization steps of the position and velocities
+	FIntVector position = FIntVector::ZeroValue;
+	FIntVector linearVel = FIntVector::ZeroValue;
+	FIntVector angularVel = FIntVector::ZeroValue;
+
+	FQuantizedRotation rotation;
+
+	//is the object absent at this position
+	bool isNull = true;
+
+	//Quantize a recorded state
+	static FTimelineNetState Quantize(const FRewindStruct& point, float positionPrecision, float velocityPrecision);
+
+	//Restore a recorded state
+	void Dequantize(float positionPrecision, float velocityPrecision, FRewindStruct& outPoint) const;
+
+	//Write only the parts of this state that differ from a baseline
+	void WriteDelta(FBitWriter& writer, const FTimelineNetState& baseline) const;
+
+	//Read a state written as the difference from a baseline
+	void ReadDelta(FBitReader& reader, const FTimelineNetState& baseline);
+
+	//Are two recorded states close enough that the difference between them is not worth correcting
+	static bool IsNearlyEqual(const FRewindStruct& first, const FRewindStruct& second, float positionTolerance, float rotationTolerance, float speedTolerance);
+
+	bool operator==(const FTimelineNetState& other) const;
+	bool operator!=(const FTimelineNetState& other) const;
+};
+
+/**
+ * Playback states of every object with a net id at one playback position, quantized once and sent to every connection
+ */
+struct TIMEREWIND_API FTimelineNetFrame
+{
+	//playback index and branch the states were read at, INDEX_NONE until the first frame is built
+	int32 playbackIndex = INDEX_NONE;
+	int32 branchId = INDEX_NONE;
+
+	//server world time the playback index was recorded at, sent with the states so clients compare them against the same moment
+	double playbackWorldTime = 0.0;
+
+	//net id, quantized state and the state clients restore from it for each object with a net id
+	TArray<uint32> netIds;
+	TArray<FTimelineNetState> states;
+	TArray<FRewindStruct> points;
+};
+
+/**
+ * What the server has sent one client connection during playback
+ */
+struct TIMEREWIND_API FTimelineConnectionState
+{
+	//last state sent for each object id, the baseline for the next delta
+	TMap<uint32, FTimelineNetState> baselines;
+
+	//should the next packet tell the client to drop its baselines
+	bool needsBaselineReset = true;
+
+	//frame entry to continue from when the last packet ran out of bandwidth
+	int32 nextEntryIndex = 0;
+
+	//playback index every changed object was sent for, INDEX_NONE if the connection still has objects to catch up on
+	int32 sentPlaybackIndex = INDEX_NONE;
+
+	//branch the sent playback index was played back from
+	int32 sentBranchId = INDEX_NONE;
+
+	//bytes the connection can still be sent, refilled over time up to one second's worth
+	float byteAllowance = 0.0f;
+};
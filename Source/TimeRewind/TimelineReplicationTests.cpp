@@ -0,0 +1,86 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineReplication.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+//Is every part of two states the same, including the parts of absent objects that operator== ignores
+static bool IsSameNetState(const FTimelineNetState& first, const FTimelineNetState& second)
+{
+	return first.isNull == second.isNull && first.position == second.position && first.linearVel == second.linearVel && first.angularVel == second.angularVel
+		&& first.rotation.x == second.rotation.x && first.rotation.y == second.rotation.y && first.rotation.z == second.rotation.z && first.rotation.w == second.rotation.w;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineNetStateRoundTripTest, "TimeRewind.Replication.DeltaRoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Send an object that disappears and comes back, keeping baselines on both ends the way the manager does
+bool FTimelineNetStateRoundTripTest::RunTest(const FString& Parameters)
+{
+	const float positionPrecision = 0.1f;
+	const float velocityPrecision = 1.0f;
+
+	TArray<FRewindStruct> points;
+	points.SetNum(4);
+
+	points[0].isNull = false;
+	points[0].position = FVector(120.0f, -45.5f, 300.0f);
+	points[0].rotation = FRotator(10.0f, 45.0f, -5.0f);
+	points[0].linearVel = FVector(-200.0f, 15.0f, 0.0f);
+	points[0].angularVel = FVector(0.5f, 0.0f, -1.25f);
+
+	points[1].isNull = true;
+
+	points[2].isNull = false;
+	points[2].position = FVector(-80.0f, 10.0f, 150.0f);
+	points[2].rotation = FRotator(0.0f, -90.0f, 0.0f);
+	points[2].linearVel = FVector::ZeroVector;
+	points[2].angularVel = FVector(0.0f, 2.0f, 0.0f);
+
+	//only the velocity changes, so the delta leaves the rest to the baseline
+	points[3] = points[2];
+	points[3].linearVel = FVector(0.0f, 0.0f, -980.0f);
+
+	FTimelineNetState senderBaseline;
+	FTimelineNetState receiverBaseline;
+
+	for (int32 pointIndex = 0; pointIndex < points.Num(); pointIndex++)
+	{
+		FTimelineNetState sent = FTimelineNetState::Quantize(points[pointIndex], positionPrecision, velocityPrecision);
+
+		FBitWriter writer(0, true);
+		sent.WriteDelta(writer, senderBaseline);
+
+		FBitReader reader(writer.GetData(), writer.GetNumBits());
+		FTimelineNetState received;
+		received.ReadDelta(reader, receiverBaseline);
+
+		TestFalse(FString::Printf(TEXT("State %d reads without error"), pointIndex), reader.IsError());
+		TestTrue(FString::Printf(TEXT("State %d matches what was sent"), pointIndex), IsSameNetState(sent, received));
+
+		senderBaseline = sent;
+		receiverBaseline = received;
+
+		FRewindStruct restored;
+		received.Dequantize(positionPrecision, velocityPrecision, restored);
+
+		TestEqual(FString::Printf(TEXT("State %d null flag"), pointIndex), restored.isNull, points[pointIndex].isNull);
+
+		if (!points[pointIndex].isNull)
+		{
+			TestTrue(FString::Printf(TEXT("State %d is within the correction tolerances of the original"), pointIndex),
+				FTimelineNetState::IsNearlyEqual(restored, points[pointIndex], positionPrecision, 0.5f, velocityPrecision));
+		}
+	}
+
+	return true;
+}
+
+#endif
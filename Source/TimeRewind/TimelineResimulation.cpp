@@ -0,0 +1,224 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineResimulation.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "EngineUtils.h"
+#include "PreviewScene.h"
+#include "TimelineStaticCollisionComponent.h"
+
+FTimelineResimulator::FTimelineResimulator()
+{
+}
+
+FTimelineResimulator::~FTimelineResimulator()
+{
+	Reset();
+}
+
+//Check if every position of the segment has been resimulated
+bool FTimelineResimulationSegment::IsFinished() const
+{
+	return nextIndex >= endIndex;
+}
+
+//Forget the segment and its positions
+void FTimelineResimulationSegment::Reset()
+{
+	segmentTick = INDEX_NONE;
+	startIndex = 0;
+	endIndex = 0;
+	nextIndex = 0;
+	handles.Reset();
+	points.Reset();
+}
+
+//Create the resimulation world and copy the static collision of a world into it
+void FTimelineResimulator::Init(UWorld* sourceWorld)
+{
+	Reset();
+
+	if (sourceWorld == nullptr)
+	{
+		return;
+	}
+
+	//the world only needs physics, it is never rendered, heard or saved
+	previewScene = MakeUnique<FPreviewScene>(FPreviewScene::ConstructionValues()
+		.SetCreatePhysicsScene(true)
+		.ShouldSimulatePhysics(true)
+		.AllowAudioPlayback(false)
+		.SetTransactional(false));
+
+	//copy the collision of every static component the recorded objects could land on or bounce off,
+	//whether it is a mesh, a brush, a shape or a landscape
+	//instanced meshes are left out, they are debris recorded on their own rather than level collision
+	for (TActorIterator<AActor> actorIterator(sourceWorld); actorIterator; ++actorIterator)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> primitives(*actorIterator);
+
+		for (UPrimitiveComponent* primitive : primitives)
+		{
+			if (primitive->Mobility != EComponentMobility::Static || !primitive->IsCollisionEnabled() || !primitive->IsPhysicsStateCreated()
+				|| primitive->IsA<UInstancedStaticMeshComponent>())
+			{
+				continue;
+			}
+
+			UTimelineStaticCollisionComponent* collisionCopy = NewObject<UTimelineStaticCollisionComponent>(GetTransientPackage(), NAME_None, RF_Transient);
+			FTransform copyTransform = collisionCopy->CopyCollision(primitive);
+
+			if (collisionCopy->GetBodySetup() != nullptr)
+			{
+				previewScene->AddComponent(collisionCopy, copyTransform);
+			}
+		}
+	}
+}
+
+//Check if the resimulation world exists
+bool FTimelineResimulator::IsInitialized() const
+{
+	return previewScene.IsValid();
+}
+
+//Destroy the resimulation world and every body in it
+void FTimelineResimulator::Reset()
+{
+	bodies.Reset();
+	previewScene.Reset();
+}
+
+//Place an object's body at a recorded state, simulating from it or moving to it kinematically
+void FTimelineResimulator::SetBodyState(UShapeComponent* sourceShape, const FRewindStruct& state, bool isSimulated, bool isTeleport)
+{
+	if (!IsInitialized() || sourceShape == nullptr)
+	{
+		return;
+	}
+
+	FResimulatedBody& body = bodies.FindOrAdd(TObjectKey<UShapeComponent>(sourceShape));
+
+	if (!body.shape.IsValid())
+	{
+		body.shape = CopyShape(sourceShape);
+	}
+
+	UShapeComponent* shape = body.shape.Get();
+
+	if (shape == nullptr)
+	{
+		return;
+	}
+
+	//absent objects stop colliding until they are back
+	if (state.isNull)
+	{
+		if (!body.isNull)
+		{
+			shape->SetSimulatePhysics(false);
+			shape->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			body.isNull = true;
+		}
+
+		return;
+	}
+
+	if (body.isNull)
+	{
+		shape->SetCollisionEnabled(sourceShape->GetCollisionEnabled());
+		body.isNull = false;
+	}
+
+	if (shape->IsSimulatingPhysics() != isSimulated)
+	{
+		shape->SetSimulatePhysics(isSimulated);
+	}
+
+	ETeleportType teleportType = isSimulated || isTeleport ? ETeleportType::TeleportPhysics : ETeleportType::None;
+	shape->SetWorldLocationAndRotation(state.position, state.rotation, false, nullptr, teleportType);
+
+	//simulated bodies carry on from the recorded velocities
+	if (isSimulated)
+	{
+		shape->SetPhysicsLinearVelocity(state.linearVel);
+		shape->SetPhysicsAngularVelocityInRadians(state.angularVel);
+		shape->WakeRigidBody();
+	}
+}
+
+//Advance the resimulation world by one fixed step
+void FTimelineResimulator::Step(float stepSeconds)
+{
+	if (!IsInitialized())
+	{
+		return;
+	}
+
+	previewScene->GetWorld()->Tick(LEVELTICK_All, stepSeconds);
+}
+
+//Read the simulated state of an object's body
+bool FTimelineResimulator::GetBodyState(UShapeComponent* sourceShape, FRewindStruct& outState) const
+{
+	const FResimulatedBody* body = bodies.Find(TObjectKey<UShapeComponent>(sourceShape));
+	const UShapeComponent* shape = body != nullptr ? body->shape.Get() : nullptr;
+
+	if (shape == nullptr)
+	{
+		return false;
+	}
+
+	outState = FRewindStruct();
+	outState.isNull = body->isNull;
+	outState.resetPosition = false;
+
+	if (body->isNull)
+	{
+		return true;
+	}
+
+	outState.position = shape->GetComponentLocation();
+	outState.rotation = shape->GetComponentRotation();
+	outState.linearVel = shape->GetPhysicsLinearVelocity();
+	outState.angularVel = shape->GetPhysicsAngularVelocityInRadians();
+
+	return true;
+}
+
+//Create a shape with the same shape and collision as another in the resimulation world
+UShapeComponent* FTimelineResimulator::CopyShape(const UShapeComponent* sourceShape)
+{
+	UShapeComponent* shapeCopy = NewObject<UShapeComponent>(GetTransientPackage(), sourceShape->GetClass(), NAME_None, RF_Transient);
+
+	//only the shapes the manager records are copied, anything else keeps its class defaults
+	if (const UBoxComponent* sourceBox = Cast<UBoxComponent>(sourceShape))
+	{
+		CastChecked<UBoxComponent>(shapeCopy)->SetBoxExtent(sourceBox->GetUnscaledBoxExtent(), false);
+	}
+	else if (const USphereComponent* sourceSphere = Cast<USphereComponent>(sourceShape))
+	{
+		CastChecked<USphereComponent>(shapeCopy)->SetSphereRadius(sourceSphere->GetUnscaledSphereRadius(), false);
+	}
+	else if (const UCapsuleComponent* sourceCapsule = Cast<UCapsuleComponent>(sourceShape))
+	{
+		CastChecked<UCapsuleComponent>(shapeCopy)->SetCapsuleSize(sourceCapsule->GetUnscaledCapsuleRadius(), sourceCapsule->GetUnscaledCapsuleHalfHeight(), false);
+	}
+
+	shapeCopy->SetMobility(EComponentMobility::Movable);
+	shapeCopy->BodyInstance.CopyBodyInstancePropertiesFrom(&sourceShape->BodyInstance);
+	shapeCopy->SetVisibility(false);
+
+	previewScene->AddComponent(shapeCopy, sourceShape->GetComponentTransform());
+
+	return shapeCopy;
+}
@@ -0,0 +1,96 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ShapeComponent.h"
+#include "RewindStruct.h"
+#include "TimelineHandle.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class FPreviewScene;
+
+/**
+ * Body standing in for a tracked object in the resimulation world
+ */
+struct TIMEREWIND_API FResimulatedBody
+{
+	//copy of the object's shape and collision
+	TWeakObjectPtr<UShapeComponent> shape;
+
+	//is the object absent, with its body taken out of the simulation until it is back
+	bool isNull = false;
+};
+
+/**
+ * Snapshot segment being resimulated a few steps at a time, so the cost is spread over several frames
+ */
+struct TIMEREWIND_API FTimelineResimulationSegment
+{
+	//absolute tick of the segment's snapshot, INDEX_NONE if unused
+	int64 segmentTick = INDEX_NONE;
+
+	//timeline index of the segment's first position, one past its last, and the next one to step to
+	int startIndex = 0;
+	int endIndex = 0;
+	int nextIndex = 0;
+
+	//objects recorded with snapshots when the segment started and their resimulated positions so far
+	TArray<FTimelineHandle> handles;
+	TArray<TArray<FRewindStruct>> points;
+
+	//Check if every position of the segment has been resimulated
+	bool IsFinished() const;
+
+	//Forget the segment and its positions
+	void Reset();
+};
+
+/**
+ * Separate physics world that rebuilds positions a snapshot timeline skipped by simulating them again at the recording's fixed step.
+ * Static collision of the recorded world is copied in once and every tracked object gets a body with the same shape and collision.
+ * Objects being resimulated start from a snapshot and simulate, every other object is moved kinematically along its recording
+ * so the resimulated ones still collide with it.
+ */
+class TIMEREWIND_API FTimelineResimulator
+{
+public:
+	FTimelineResimulator();
+	~FTimelineResimulator();
+
+	//Create the resimulation world and copy the static collision of a world into it
+	void Init(UWorld* sourceWorld);
+
+	//Check if the resimulation world exists
+	bool IsInitialized() const;
+
+	//Destroy the resimulation world and every body in it
+	void Reset();
+
+	//Place an object's body at a recorded state, simulating from it or moving to it kinematically
+	//Kinematic bodies sweep to the state unless teleported, so they push simulated bodies out of the way
+	void SetBodyState(UShapeComponent* sourceShape, const FRewindStruct& state, bool isSimulated, bool isTeleport);
+
+	//Advance the resimulation world by one fixed step
+	void Step(float stepSeconds);
+
+	//Read the simulated state of an object's body. Returns false if the object has no body
+	bool GetBodyState(UShapeComponent* sourceShape, FRewindStruct& outState) const;
+
+private:
+	//world the bodies simulate in, kept apart from the game world
+	TUniquePtr<FPreviewScene> previewScene;
+
+	//body of each tracked object, created the first time the object is resimulated
+	TMap<TObjectKey<UShapeComponent>, FResimulatedBody> bodies;
+
+	//Create a shape with the same shape and collision as another in the resimulation world
+	UShapeComponent* CopyShape(const UShapeComponent* sourceShape);
+};
@@ -0,0 +1,335 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineSnapshot.h"
+#include "Algo/BinarySearch.h"
+
+FKeyframeTimeline::FKeyframeTimeline(float newTickSeconds)
+	: tickSeconds(newTickSeconds)
+{
+}
+
+uint32 FKeyframeTimeline::GetChannels() const
+{
+	return ETimelineChannel::Position | ETimelineChannel::Rotation | ETimelineChannel::LinearVelocity | ETimelineChannel::AngularVelocity;
+}
+
+int32 FKeyframeTimeline::GetStride() const
+{
+	return sizeof(FTimelineKeyframe);
+}
+
+int32 FKeyframeTimeline::Num() const
+{
+	return numPoints;
+}
+
+int64 FKeyframeTimeline::GetAllocatedBytes() const
+{
+	return keys.GetAllocatedSize();
+}
+
+void FKeyframeTimeline::Init(int numPositions)
+{
+	Reset();
+	numPoints = FMath::Max(numPositions, 0);
+}
+
+void FKeyframeTimeline::Reset()
+{
+	keys.Empty();
+	numPoints = 0;
+	firstTick = 0;
+	hasLatestKey = false;
+}
+
+void FKeyframeTimeline::Shift()
+{
+	if (numPoints == 0)
+	{
+		return;
+	}
+
+	firstTick++;
+
+	//drop keyframes that slid out, keeping the newest one before the window to rebuild from
+	int32 numExpired = 0;
+
+	while (numExpired + 1 < keys.Num() && keys[numExpired + 1].tick <= firstTick)
+	{
+		numExpired++;
+	}
+
+	if (numExpired > 0)
+	{
+		keys.RemoveAt(0, numExpired, false);
+	}
+}
+
+void FKeyframeTimeline::Read(int timelineIndex, FRewindStruct& outPoint) const
+{
+	int64 tick = firstTick + timelineIndex;
+
+	//nothing was written at or after this tick
+	if (!hasLatestKey || tick > latestKey.tick)
+	{
+		outPoint = FRewindStruct();
+		return;
+	}
+
+	if (tick == latestKey.tick)
+	{
+		ReadKey(latestKey, outPoint);
+		return;
+	}
+
+	//find the keyframes on either side, the latest position closes the last segment
+	int32 nextKeyIndex = Algo::UpperBoundBy(keys, tick, &FTimelineKeyframe::tick);
+
+	if (nextKeyIndex == 0)
+	{
+		outPoint = FRewindStruct();
+		return;
+	}
+
+	const FTimelineKeyframe& fromKey = keys[nextKeyIndex - 1];
+	const FTimelineKeyframe& toKey = keys.IsValidIndex(nextKeyIndex) ? keys[nextKeyIndex] : latestKey;
+
+	//exact keyframes, null stretches and anything leading into a teleport hold the earlier keyframe
+	if (tick == fromKey.tick || fromKey.isNull || toKey.isNull || toKey.resetPosition || toKey.tick <= fromKey.tick)
+	{
+		ReadKey(fromKey, outPoint);
+		outPoint.resetPosition = outPoint.resetPosition && tick == fromKey.tick;
+		outPoint.playSound = outPoint.playSound && tick == fromKey.tick;
+		return;
+	}
+
+	Rebuild(fromKey, toKey, tick, outPoint);
+	outPoint.resetPosition = false;
+	outPoint.isNull = false;
+	outPoint.playSound = false;
+}
+
+void FKeyframeTimeline::Write(int timelineIndex, const FRewindStruct& point)
+{
+	int64 tick = firstTick + timelineIndex;
+
+	//writing over earlier positions, such as when resuming from playback, discards everything from there on
+	if (hasLatestKey && tick <= latestKey.tick)
+	{
+		keys.SetNum(Algo::LowerBoundBy(keys, tick, &FTimelineKeyframe::tick), false);
+		hasLatestKey = keys.Num() > 0;
+
+		if (hasLatestKey)
+		{
+			latestKey = keys.Last();
+		}
+	}
+
+	FTimelineKeyframe newKey = MakeKey(tick, point);
+
+	//a position the curve cannot rebuild across keeps the position before it, so nothing leading up to it is lost
+	bool isLatestKept = keys.Num() > 0 && keys.Last().tick == latestKey.tick;
+	bool breaksCurve = !hasLatestKey || tick != latestKey.tick + 1 || newKey.resetPosition || newKey.isNull != latestKey.isNull || newKey.playSound;
+
+	//measure acceleration across consecutive positions for keyframes that predict motion
+	if (!breaksCurve && tickSeconds > 0.0f)
+	{
+		newKey.linearAccel = (newKey.linearVel - latestKey.linearVel) / tickSeconds;
+	}
+
+	if (hasLatestKey && breaksCurve && !isLatestKept)
+	{
+		keys.Add(latestKey);
+	}
+
+	//keep player events, state changes and whatever else the subclass needs to rebuild the rest
+	if (breaksCurve || keys.Num() == 0 || NeedsKey(keys.Last(), newKey))
+	{
+		keys.Add(newKey);
+	}
+
+	latestKey = newKey;
+	hasLatestKey = true;
+}
+
+void FKeyframeTimeline::CaptureState(UShapeComponent* physicsObj, FRewindStruct& outPoint) const
+{
+	//automated positions are valid, not resets and play no sound
+	outPoint = FRewindStruct();
+	outPoint.isNull = false;
+	outPoint.resetPosition = false;
+	outPoint.playSound = false;
+
+	outPoint.position = physicsObj->GetComponentLocation();
+	outPoint.rotation = physicsObj->GetComponentRotation();
+	outPoint.linearVel = physicsObj->GetPhysicsLinearVelocity();
+	outPoint.angularVel = physicsObj->GetPhysicsAngularVelocityInRadians();
+}
+
+//Check if the position at a timeline index was kept exactly instead of being rebuilt
+bool FKeyframeTimeline::IsKeyframe(int timelineIndex) const
+{
+	int64 tick = firstTick + timelineIndex;
+
+	if (hasLatestKey && tick == latestKey.tick)
+	{
+		return true;
+	}
+
+	int32 keyIndex = Algo::LowerBoundBy(keys, tick, &FTimelineKeyframe::tick);
+
+	return keys.IsValidIndex(keyIndex) && keys[keyIndex].tick == tick;
+}
+
+//Convert a rewind struct to a keyframe
+FTimelineKeyframe FKeyframeTimeline::MakeKey(int64 tick, const FRewindStruct& point)
+{
+	FTimelineKeyframe key;
+	key.tick = tick;
+	key.position = FVector3f(point.position);
+	key.rotation = FQuat4f(point.rotation.Quaternion());
+	key.linearVel = FVector3f(point.linearVel);
+	key.angularVel = FVector3f(point.angularVel);
+	key.resetPosition = point.resetPosition;
+	key.isNull = point.isNull;
+	key.playSound = point.playSound;
+
+	return key;
+}
+
+//Convert a kept keyframe to a rewind struct
+void FKeyframeTimeline::ReadKey(const FTimelineKeyframe& key, FRewindStruct& outPoint)
+{
+	outPoint.position = FVector(key.position);
+	outPoint.rotation = FRotator(FQuat(key.rotation));
+	outPoint.linearVel = FVector(key.linearVel);
+	outPoint.angularVel = FVector(key.angularVel);
+	outPoint.resetPosition = key.resetPosition;
+	outPoint.isNull = key.isNull;
+	outPoint.playSound = key.playSound;
+}
+
+FSnapshotTimeline::FSnapshotTimeline(int32 newSnapshotTicks, int64 newTickOrigin, float newTickSeconds)
+	: FKeyframeTimeline(newTickSeconds)
+	, snapshotTicks(FMath::Max(newSnapshotTicks, 1))
+	, tickOrigin(newTickOrigin)
+{
+}
+
+ETimelineLayout FSnapshotTimeline::GetLayout() const
+{
+	return ETimelineLayout::Snapshots;
+}
+
+int64 FSnapshotTimeline::GetAllocatedBytes() const
+{
+	return FKeyframeTimeline::GetAllocatedBytes() + resimulatedPoints.GetAllocatedSize();
+}
+
+void FSnapshotTimeline::Reset()
+{
+	FKeyframeTimeline::Reset();
+	resimulatedPoints.Empty();
+}
+
+void FSnapshotTimeline::Write(int timelineIndex, const FRewindStruct& point)
+{
+	//anything written changes what a resimulation from the snapshots would give
+	resimulatedPoints.Reset();
+
+	FKeyframeTimeline::Write(timelineIndex, point);
+}
+
+//Use resimulated positions starting at a timeline index instead of rebuilding them from the snapshots
+void FSnapshotTimeline::SetResimulatedSegment(int firstTimelineIndex, TArray<FRewindStruct>&& points)
+{
+	resimulatedPoints = MoveTemp(points);
+	resimulatedFirstTick = firstTick + firstTimelineIndex;
+}
+
+//Keep one snapshot every interval, on the same ticks for every object
+bool FSnapshotTimeline::NeedsKey(const FTimelineKeyframe& lastKey, const FTimelineKeyframe& newKey) const
+{
+	return (tickOrigin + newKey.tick) % snapshotTicks == 0 || newKey.tick - lastKey.tick >= snapshotTicks;
+}
+
+//Rebuild the position at a tick between two snapshots
+void FSnapshotTimeline::Rebuild(const FTimelineKeyframe& fromKey, const FTimelineKeyframe& toKey, int64 tick, FRewindStruct& outPoint) const
+{
+	//positions resimulated for the segment being played back replace the curve
+	int64 resimulatedIndex = tick - resimulatedFirstTick;
+
+	if (resimulatedIndex >= 0 && resimulatedIndex < resimulatedPoints.Num())
+	{
+		outPoint = resimulatedPoints[int32(resimulatedIndex)];
+		return;
+	}
+
+	float alpha = float(tick - fromKey.tick) / float(toKey.tick - fromKey.tick);
+	float segmentSeconds = float(toKey.tick - fromKey.tick) * tickSeconds;
+
+	//velocities are the curve's tangents, scaled to the length of the segment
+	FVector3f position = FMath::CubicInterp(fromKey.position, fromKey.linearVel * segmentSeconds, toKey.position, toKey.linearVel * segmentSeconds, alpha);
+
+	outPoint.position = FVector(position);
+	outPoint.rotation = FRotator(FQuat(FQuat4f::Slerp(fromKey.rotation, toKey.rotation, alpha)));
+	outPoint.linearVel = FVector(FMath::Lerp(fromKey.linearVel, toKey.linearVel, alpha));
+	outPoint.angularVel = FVector(FMath::Lerp(fromKey.angularVel, toKey.angularVel, alpha));
+}
+
+FExtrapolatedTimeline::FExtrapolatedTimeline(float newPositionTolerance, float newRotationTolerance, float newTickSeconds)
+	: FKeyframeTimeline(newTickSeconds)
+	, positionTolerance(FMath::Max(newPositionTolerance, 0.0f))
+	, rotationTolerance(FMath::Max(newRotationTolerance, 0.0f))
+{
+}
+
+ETimelineLayout FExtrapolatedTimeline::GetLayout() const
+{
+	return ETimelineLayout::Extrapolated;
+}
+
+//Keep a keyframe once the last keyframe's prediction drifts past the tolerances
+bool FExtrapolatedTimeline::NeedsKey(const FTimelineKeyframe& lastKey, const FTimelineKeyframe& newKey) const
+{
+	FTimelineKeyframe predictedKey = Extrapolate(lastKey, newKey.tick);
+
+	return FVector3f::DistSquared(predictedKey.position, newKey.position) > FMath::Square(positionTolerance)
+		|| predictedKey.rotation.AngularDistance(newKey.rotation) > rotationTolerance;
+}
+
+//Rebuild a skipped position with the same prediction recording checked it against
+void FExtrapolatedTimeline::Rebuild(const FTimelineKeyframe& fromKey, const FTimelineKeyframe& toKey, int64 tick, FRewindStruct& outPoint) const
+{
+	ReadKey(Extrapolate(fromKey, tick), outPoint);
+}
+
+//Predict the state a keyframe moves to by a later tick
+FTimelineKeyframe FExtrapolatedTimeline::Extrapolate(const FTimelineKeyframe& fromKey, int64 tick) const
+{
+	float seconds = float(tick - fromKey.tick) * tickSeconds;
+
+	FTimelineKeyframe predictedKey = fromKey;
+	predictedKey.tick = tick;
+
+	//constant acceleration covers falling and sliding to a stop
+	predictedKey.position = fromKey.position + fromKey.linearVel * seconds + fromKey.linearAccel * (0.5f * seconds * seconds);
+	predictedKey.linearVel = fromKey.linearVel + fromKey.linearAccel * seconds;
+
+	//spin at the keyframe's world angular velocity
+	float spinSpeed = fromKey.angularVel.Size();
+
+	if (spinSpeed > KINDA_SMALL_NUMBER)
+	{
+		predictedKey.rotation = FQuat4f(fromKey.angularVel / spinSpeed, spinSpeed * seconds) * fromKey.rotation;
+	}
+
+	return predictedKey;
+}
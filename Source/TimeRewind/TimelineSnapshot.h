@@ -0,0 +1,154 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TimelineLayout.h"
+
+/**
+ * Position kept by a keyframe timeline
+ */
+struct TIMEREWIND_API FTimelineKeyframe
+{
+	//tick this position was recorded at, counted from the start of the timeline
+	int64 tick = 0;
+
+	FVector3f position = FVector3f::ZeroVector;
+	FQuat4f rotation = FQuat4f::Identity;
+	FVector3f linearVel = FVector3f::ZeroVector;
+	FVector3f angularVel = FVector3f::ZeroVector;
+
+	//change in linear velocity per second measured from the position before this one
+	FVector3f linearAccel = FVector3f::ZeroVector;
+
+	bool resetPosition = false;
+	bool isNull = true;
+	bool playSound = false;
+};
+
+/**
+ * Timeline keeping only some positions as keyframes and rebuilding the rest when read.
+ * Player events such as a projectile being fired, sounds and null changes are always kept, along with the position before them,
+ * so only smooth motion between keyframes is ever rebuilt. Subclasses pick which other positions to keep and how to rebuild.
+ */
+class TIMEREWIND_API FKeyframeTimeline : public FTimeline
+{
+public:
+	FKeyframeTimeline(float newTickSeconds);
+
+	virtual uint32 GetChannels() const override;
+	virtual int32 GetStride() const override;
+	virtual int32 Num() const override;
+	virtual int64 GetAllocatedBytes() const override;
+	virtual void Init(int numPositions) override;
+	virtual void Reset() override;
+	virtual void Shift() override;
+	virtual void Read(int timelineIndex, FRewindStruct& outPoint) const override;
+	virtual void Write(int timelineIndex, const FRewindStruct& point) override;
+	virtual void CaptureState(UShapeComponent* physicsObj, FRewindStruct& outPoint) const override;
+
+	//Check if the position at a timeline index was kept exactly instead of being rebuilt
+	bool IsKeyframe(int timelineIndex) const;
+
+protected:
+	//seconds between ticks, used to scale velocities when rebuilding positions
+	float tickSeconds = 0.0f;
+
+	//tick of timeline index 0, increased by one each shift
+	int64 firstTick = 0;
+
+	//Check if a new position should be kept as a keyframe after the last kept keyframe
+	virtual bool NeedsKey(const FTimelineKeyframe& lastKey, const FTimelineKeyframe& newKey) const = 0;
+
+	//Rebuild the position at a tick after one keyframe and before the next
+	virtual void Rebuild(const FTimelineKeyframe& fromKey, const FTimelineKeyframe& toKey, int64 tick, FRewindStruct& outPoint) const = 0;
+
+	//Convert a kept keyframe to a rewind struct
+	static void ReadKey(const FTimelineKeyframe& key, FRewindStruct& outPoint);
+
+private:
+	//number of positions in the timeline
+	int32 numPoints = 0;
+
+	//kept keyframes sorted by tick. The newest keyframe before the window is kept to rebuild the first positions
+	TArray<FTimelineKeyframe> keys;
+
+	//most recent position written, kept until the next keyframe so the end of the timeline reads exactly
+	FTimelineKeyframe latestKey;
+
+	//false until the first write
+	bool hasLatestKey = false;
+
+	//Convert a rewind struct to a keyframe
+	static FTimelineKeyframe MakeKey(int64 tick, const FRewindStruct& point);
+};
+
+/**
+ * Keyframe timeline keeping a full physics state only every few seconds.
+ * Snapshots fall on the same absolute ticks for every object, so the whole scene can be resimulated from one of them.
+ * The manager resimulates the segment being played back, and then the one after it, on a separate physics world a few
+ * steps per frame and hands the positions back, so memory drops by the snapshot interval and playback pays for it in physics steps.
+ * Positions outside the resimulated segment are rebuilt by a cubic Hermite curve through the surrounding snapshots.
+ */
+class TIMEREWIND_API FSnapshotTimeline final : public FKeyframeTimeline
+{
+public:
+	FSnapshotTimeline(int32 newSnapshotTicks, int64 newTickOrigin, float newTickSeconds);
+
+	virtual ETimelineLayout GetLayout() const override;
+	virtual int64 GetAllocatedBytes() const override;
+	virtual void Reset() override;
+	virtual void Write(int timelineIndex, const FRewindStruct& point) override;
+
+	//Use resimulated positions starting at a timeline index instead of rebuilding them from the snapshots
+	void SetResimulatedSegment(int firstTimelineIndex, TArray<FRewindStruct>&& points);
+
+protected:
+	virtual bool NeedsKey(const FTimelineKeyframe& lastKey, const FTimelineKeyframe& newKey) const override;
+	virtual void Rebuild(const FTimelineKeyframe& fromKey, const FTimelineKeyframe& toKey, int64 tick, FRewindStruct& outPoint) const override;
+
+private:
+	//ticks between kept snapshots
+	int32 snapshotTicks = 1;
+
+	//absolute recording tick of this timeline's first tick, snapshots are kept on multiples of the interval from absolute tick 0
+	int64 tickOrigin = 0;
+
+	//positions of the last resimulated segment and the tick of its first position
+	TArray<FRewindStruct> resimulatedPoints;
+	int64 resimulatedFirstTick = 0;
+};
+
+/**
+ * Keyframe timeline keeping a position only when motion stops following the last keyframe.
+ * Each keyframe predicts the positions after it from its velocities and acceleration, and recording keeps a new keyframe
+ * once the prediction drifts further than the position or rotation tolerance. Playback rebuilds skipped positions with the
+ * same prediction, so ballistic and sliding objects need a keyframe per bounce instead of one per tick.
+ */
+class TIMEREWIND_API FExtrapolatedTimeline final : public FKeyframeTimeline
+{
+public:
+	FExtrapolatedTimeline(float newPositionTolerance, float newRotationTolerance, float newTickSeconds);
+
+	virtual ETimelineLayout GetLayout() const override;
+
+protected:
+	virtual bool NeedsKey(const FTimelineKeyframe& lastKey, const FTimelineKeyframe& newKey) const override;
+	virtual void Rebuild(const FTimelineKeyframe& fromKey, const FTimelineKeyframe& toKey, int64 tick, FRewindStruct& outPoint) const override;
+
+private:
+	//distance a prediction may drift before a keyframe is kept
+	float positionTolerance = 1.0f;
+
+	//rotation in radians a prediction may drift before a keyframe is kept
+	float rotationTolerance = 0.02f;
+
+	//Predict the state a keyframe moves to by a later tick
+	FTimelineKeyframe Extrapolate(const FTimelineKeyframe& fromKey, int64 tick) const;
+};
@@ -0,0 +1,191 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineSpatialIndex.h"
+
+//Set up a ring of buckets covering a number of recorded positions
+void FTimelineSpatialIndex::Init(int numPositions, int32 newTicksPerBucket, float newCellSize)
+{
+	ticksPerBucket = FMath::Max(newTicksPerBucket, 1);
+	cellSize = FMath::Max(newCellSize, 1.0f);
+
+	//one larger than the window so a partially recorded bucket at each end still fits
+	buckets.Reset();
+	buckets.SetNum(FMath::DivideAndRoundUp(FMath::Max(numPositions, 1), ticksPerBucket) + 1);
+}
+
+//Remove everything from the index
+void FTimelineSpatialIndex::Reset()
+{
+	for (FTimelineSpatialBucket& bucket : buckets)
+	{
+		bucket = FTimelineSpatialBucket();
+	}
+}
+
+//Check if the index has been set up
+bool FTimelineSpatialIndex::IsInitialized() const
+{
+	return buckets.Num() > 0;
+}
+
+//Get the absolute bucket number holding an absolute tick
+int64 FTimelineSpatialIndex::GetBucketNumber(int64 tick) const
+{
+	return tick / ticksPerBucket;
+}
+
+//Add a slot's recorded position at an absolute tick
+void FTimelineSpatialIndex::Add(int64 tick, const FTimelineHandle& handle, const FVector& position, float radius, bool isTeleport, FTimelineSpatialCursor& cursor)
+{
+	int64 bucketNumber = GetBucketNumber(tick);
+	FTimelineSpatialBucket& bucket = GetRecordingBucket(bucketNumber);
+
+	//the object can be anywhere on the line from its previous position, so queries need to reach its cell from that far
+	float stepDistance = !isTeleport && cursor.tick == tick - 1 ? float(FVector::Dist(cursor.position, position)) : 0.0f;
+	float margin = radius + stepDistance;
+
+	cursor.tick = tick;
+	cursor.position = position;
+
+	//objects staying in one cell are filed once per bucket, and only look the cell up again to widen its margin
+	FIntVector cell = GetCell(position);
+	bool isSameCell = cursor.bucketNumber == bucketNumber && cursor.cell == cell;
+
+	if (isSameCell && margin <= cursor.margin)
+	{
+		return;
+	}
+
+	FTimelineSpatialCell& spatialCell = bucket.cells.FindOrAdd(cell);
+	spatialCell.margin = FMath::Max(spatialCell.margin, margin);
+	bucket.maxMargin = FMath::Max(bucket.maxMargin, margin);
+
+	if (isSameCell)
+	{
+		cursor.margin = margin;
+		return;
+	}
+
+	cursor.bucketNumber = bucketNumber;
+	cursor.cell = cell;
+	cursor.margin = margin;
+
+	spatialCell.handles.Add(handle);
+}
+
+//Add every slot filed in a bucket near a box to a set of candidates
+void FTimelineSpatialIndex::QueryBox(int64 bucketNumber, const FBox& box, TSet<FTimelineHandle>& outCandidates) const
+{
+	const FTimelineSpatialBucket* bucket = FindBucket(bucketNumber);
+
+	if (bucket == nullptr || bucket->cells.Num() == 0)
+	{
+		return;
+	}
+
+	//objects are filed by their position only, so read every cell an object in the bucket could reach the box from
+	FBox looseBox = box.ExpandBy(bucket->maxMargin);
+	FIntVector minCell = GetCell(looseBox.Min);
+	FIntVector maxCell = GetCell(looseBox.Max);
+	int64 numQueryCells = int64(maxCell.X - minCell.X + 1) * int64(maxCell.Y - minCell.Y + 1) * int64(maxCell.Z - minCell.Z + 1);
+
+	//very large boxes cover more cells than were ever filled, so walk the filled cells instead
+	if (numQueryCells > bucket->cells.Num())
+	{
+		for (const TPair<FIntVector, FTimelineSpatialCell>& cellEntry : bucket->cells)
+		{
+			const FIntVector& cell = cellEntry.Key;
+
+			if (cell.X >= minCell.X && cell.X <= maxCell.X && cell.Y >= minCell.Y && cell.Y <= maxCell.Y && cell.Z >= minCell.Z && cell.Z <= maxCell.Z)
+			{
+				AddCellCandidates(cell, cellEntry.Value, box, outCandidates);
+			}
+		}
+
+		return;
+	}
+
+	for (int32 x = minCell.X; x <= maxCell.X; x++)
+	{
+		for (int32 y = minCell.Y; y <= maxCell.Y; y++)
+		{
+			for (int32 z = minCell.Z; z <= maxCell.Z; z++)
+			{
+				FIntVector cell(x, y, z);
+
+				if (const FTimelineSpatialCell* spatialCell = bucket->cells.Find(cell))
+				{
+					AddCellCandidates(cell, *spatialCell, box, outCandidates);
+				}
+			}
+		}
+	}
+}
+
+//Add every slot filed in a bucket near a line segment to a set of candidates
+void FTimelineSpatialIndex::QuerySegment(int64 bucketNumber, const FVector& start, const FVector& end, TSet<FTimelineHandle>& outCandidates) const
+{
+	//walk the segment a cell at a time so long rays only read the cells along them, not their whole bounding box
+	int32 numSteps = FMath::Max(FMath::CeilToInt(float(FVector::Dist(start, end)) / cellSize), 1);
+	FVector stepStart = start;
+
+	for (int32 stepIndex = 1; stepIndex <= numSteps; stepIndex++)
+	{
+		FVector stepEnd = FMath::Lerp(start, end, double(stepIndex) / double(numSteps));
+
+		QueryBox(bucketNumber, FBox(stepStart.ComponentMin(stepEnd), stepStart.ComponentMax(stepEnd)), outCandidates);
+		stepStart = stepEnd;
+	}
+}
+
+//Get the grid cell holding a position
+FIntVector FTimelineSpatialIndex::GetCell(const FVector& position) const
+{
+	return FIntVector(FMath::FloorToInt(position.X / cellSize), FMath::FloorToInt(position.Y / cellSize), FMath::FloorToInt(position.Z / cellSize));
+}
+
+//Add the slots recorded in a cell to a set of candidates if the cell reaches a box
+void FTimelineSpatialIndex::AddCellCandidates(const FIntVector& cell, const FTimelineSpatialCell& spatialCell, const FBox& box, TSet<FTimelineHandle>& outCandidates) const
+{
+	FBox cellBox(FVector(cell) * cellSize, FVector(cell + FIntVector(1, 1, 1)) * cellSize);
+
+	if (cellBox.ExpandBy(spatialCell.margin).Intersect(box))
+	{
+		outCandidates.Append(spatialCell.handles);
+	}
+}
+
+//Get the ring entry for a bucket number being recorded, clearing it if it held an older bucket
+FTimelineSpatialBucket& FTimelineSpatialIndex::GetRecordingBucket(int64 bucketNumber)
+{
+	FTimelineSpatialBucket& bucket = buckets[bucketNumber % buckets.Num()];
+
+	if (bucket.bucketNumber != bucketNumber)
+	{
+		bucket.bucketNumber = bucketNumber;
+		bucket.cells.Reset();
+		bucket.maxMargin = 0.0f;
+	}
+
+	return bucket;
+}
+
+//Find the ring entry holding a bucket number
+const FTimelineSpatialBucket* FTimelineSpatialIndex::FindBucket(int64 bucketNumber) const
+{
+	if (buckets.Num() == 0 || bucketNumber < 0)
+	{
+		return nullptr;
+	}
+
+	const FTimelineSpatialBucket& bucket = buckets[bucketNumber % buckets.Num()];
+
+	return bucket.bucketNumber == bucketNumber ? &bucket : nullptr;
+}
@@ -0,0 +1,114 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TimelineHandle.h"
+
+/**
+ * Where a timeline slot was last added to the spatial index, so it is only added again when it changes cell or bucket
+ */
+struct TIMEREWIND_API FTimelineSpatialCursor
+{
+	//absolute bucket number the slot was last added to, INDEX_NONE before the first position
+	int64 bucketNumber = INDEX_NONE;
+
+	//grid cell the slot was last added to
+	FIntVector cell = FIntVector::ZeroValue;
+
+	//margin the slot has already given the cell it was last added to
+	float margin = 0.0f;
+
+	//absolute tick and position of the slot's last recorded position
+	int64 tick = INDEX_NONE;
+	FVector position = FVector::ZeroVector;
+};
+
+/**
+ * Slots recorded in one grid cell during a bucket
+ */
+struct TIMEREWIND_API FTimelineSpatialCell
+{
+	//handles of every slot recorded in the cell
+	TArray<FTimelineHandle> handles;
+
+	//largest object radius plus distance moved between two positions recorded in the cell
+	//queries reach the cell from this far away so objects are found anywhere between their recorded positions
+	float margin = 0.0f;
+};
+
+/**
+ * Grid cells touched by tracked objects during a range of recorded ticks
+ */
+struct TIMEREWIND_API FTimelineSpatialBucket
+{
+	//absolute bucket number held by this ring entry, INDEX_NONE if unused
+	int64 bucketNumber = INDEX_NONE;
+
+	//slots recorded in each cell during the bucket
+	TMap<FIntVector, FTimelineSpatialCell> cells;
+
+	//largest margin of any cell in the bucket, bounding the cells a query reads
+	//each cell is then checked with its own margin, so one fast object only widens queries near its own cells
+	float maxMargin = 0.0f;
+};
+
+/**
+ * Loose hash grid of recorded positions per range of ticks, kept up to date as positions are recorded.
+ * Each slot is filed under the cell holding its position, once per bucket and cell it visits,
+ * so a query only reads the cells around it in one or two buckets instead of every timeline.
+ * Results are candidates, callers check them against the recorded positions.
+ */
+class TIMEREWIND_API FTimelineSpatialIndex
+{
+public:
+	//Set up a ring of buckets covering a number of recorded positions
+	void Init(int numPositions, int32 newTicksPerBucket, float newCellSize);
+
+	//Remove everything from the index
+	void Reset();
+
+	//Check if the index has been set up
+	bool IsInitialized() const;
+
+	//Get the absolute bucket number holding an absolute tick
+	int64 GetBucketNumber(int64 tick) const;
+
+	//Add a slot's recorded position at an absolute tick
+	//Teleports do not grow the margin since nothing is recorded between the two positions
+	void Add(int64 tick, const FTimelineHandle& handle, const FVector& position, float radius, bool isTeleport, FTimelineSpatialCursor& cursor);
+
+	//Add every slot filed in a bucket near a box to a set of candidates
+	void QueryBox(int64 bucketNumber, const FBox& box, TSet<FTimelineHandle>& outCandidates) const;
+
+	//Add every slot filed in a bucket near a line segment to a set of candidates
+	void QuerySegment(int64 bucketNumber, const FVector& start, const FVector& end, TSet<FTimelineHandle>& outCandidates) const;
+
+private:
+	//ring of buckets indexed by absolute bucket number
+	TArray<FTimelineSpatialBucket> buckets;
+
+	//number of recorded ticks filed in each bucket
+	int32 ticksPerBucket = 1;
+
+	//size of each grid cell
+	float cellSize = 1.0f;
+
+	//Get the grid cell holding a position
+	FIntVector GetCell(const FVector& position) const;
+
+	//Add the slots recorded in a cell to a set of candidates if the cell reaches a box
+	void AddCellCandidates(const FIntVector& cell, const FTimelineSpatialCell& spatialCell, const FBox& box, TSet<FTimelineHandle>& outCandidates) const;
+
+	//Get the ring entry for a bucket number being recorded, clearing it if it held an older bucket
+	FTimelineSpatialBucket& GetRecordingBucket(int64 bucketNumber);
+
+	//Find the ring entry holding a bucket number. Returns nullptr if it is not in the index
+	const FTimelineSpatialBucket* FindBucket(int64 bucketNumber) const;
+};
@@ -0,0 +1,112 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineSpatialIndex.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineSpatialIndexQueriesTest, "TimeRewind.SpatialIndex.Queries", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Record a slow and a fast object, checking box and segment queries across a bucket boundary and after the ring wraps
+bool FTimelineSpatialIndexQueriesTest::RunTest(const FString& Parameters)
+{
+	//20 positions in buckets of 5 ticks gives a ring of 5 buckets
+	FTimelineSpatialIndex spatialIndex;
+	spatialIndex.Init(20, 5, 100.0f);
+
+	TestTrue(TEXT("Index is initialized"), spatialIndex.IsInitialized());
+
+	FTimelineHandle slowHandle(0, 1);
+	FTimelineHandle fastHandle(1, 1);
+	FTimelineSpatialCursor slowCursor;
+	FTimelineSpatialCursor fastCursor;
+
+	FVector firstSlowPosition(50.0f, 50.0f, 50.0f);
+	FVector secondSlowPosition(150.0f, 50.0f, 50.0f);
+	FVector boxExtent(10.0f);
+
+	//bucket 0 holds the slow object sitting still and the fast object moving 2000 units a tick
+	for (int64 tick = 0; tick < 5; tick++)
+	{
+		spatialIndex.Add(tick, slowHandle, firstSlowPosition, 10.0f, false, slowCursor);
+		spatialIndex.Add(tick, fastHandle, FVector(-5000.0f, tick * 2000.0f, 50.0f), 10.0f, false, fastCursor);
+	}
+
+	TSet<FTimelineHandle> candidates;
+
+	spatialIndex.QueryBox(0, FBox::BuildAABB(firstSlowPosition, boxExtent), candidates);
+	TestTrue(TEXT("Box around the slow object finds it"), candidates.Contains(slowHandle));
+	TestFalse(TEXT("Box around the slow object skips the distant fast object"), candidates.Contains(fastHandle));
+
+	//the fast object's margin stays on its own cells instead of widening every query in the bucket
+	candidates.Reset();
+	spatialIndex.QueryBox(0, FBox::BuildAABB(FVector(1500.0f, 50.0f, 50.0f), boxExtent), candidates);
+	TestEqual(TEXT("Empty space near the slow object finds nothing"), candidates.Num(), 0);
+
+	candidates.Reset();
+	spatialIndex.QueryBox(0, FBox::BuildAABB(FVector(-5000.0f, 4000.0f, 50.0f), boxExtent), candidates);
+	TestTrue(TEXT("Box on the fast object's path finds it"), candidates.Contains(fastHandle));
+
+	//bucket 1 starts with the slow object stepping into the next cell
+	for (int64 tick = 5; tick < 10; tick++)
+	{
+		spatialIndex.Add(tick, slowHandle, secondSlowPosition, 10.0f, false, slowCursor);
+	}
+
+	candidates.Reset();
+	spatialIndex.QueryBox(1, FBox::BuildAABB(secondSlowPosition, boxExtent), candidates);
+	TestTrue(TEXT("Box around the new position finds the slow object in the next bucket"), candidates.Contains(slowHandle));
+	TestFalse(TEXT("Objects not recorded in the next bucket are not found"), candidates.Contains(fastHandle));
+
+	candidates.Reset();
+	spatialIndex.QueryBox(1, FBox::BuildAABB(firstSlowPosition, boxExtent), candidates);
+	TestTrue(TEXT("Box on the step across the bucket boundary finds the slow object"), candidates.Contains(slowHandle));
+
+	candidates.Reset();
+	spatialIndex.QueryBox(1, FBox::BuildAABB(FVector(1000.0f, 50.0f, 50.0f), boxExtent), candidates);
+	TestEqual(TEXT("Box beyond the step finds nothing"), candidates.Num(), 0);
+
+	candidates.Reset();
+	spatialIndex.QuerySegment(1, FVector(150.0f, -500.0f, 50.0f), FVector(150.0f, 500.0f, 50.0f), candidates);
+	TestTrue(TEXT("Segment through the slow object finds it"), candidates.Contains(slowHandle));
+
+	candidates.Reset();
+	spatialIndex.QuerySegment(1, FVector(1000.0f, -500.0f, 50.0f), FVector(1000.0f, 500.0f, 50.0f), candidates);
+	TestEqual(TEXT("Segment away from every object finds nothing"), candidates.Num(), 0);
+
+	//recording up to bucket 5 reuses the ring entry of bucket 0
+	for (int64 tick = 10; tick < 30; tick++)
+	{
+		spatialIndex.Add(tick, slowHandle, secondSlowPosition, 10.0f, false, slowCursor);
+	}
+
+	candidates.Reset();
+	spatialIndex.QueryBox(0, FBox::BuildAABB(firstSlowPosition, boxExtent), candidates);
+	spatialIndex.QueryBox(0, FBox::BuildAABB(FVector(-5000.0f, 4000.0f, 50.0f), boxExtent), candidates);
+	TestEqual(TEXT("Overwritten bucket finds nothing after the ring wraps"), candidates.Num(), 0);
+
+	candidates.Reset();
+	spatialIndex.QueryBox(5, FBox::BuildAABB(secondSlowPosition, boxExtent), candidates);
+	TestTrue(TEXT("Bucket reusing the ring entry finds the slow object"), candidates.Contains(slowHandle));
+	TestFalse(TEXT("Bucket reusing the ring entry drops the fast object"), candidates.Contains(fastHandle));
+
+	//margins are cleared with the ring entry, so the still object no longer reaches its old step
+	candidates.Reset();
+	spatialIndex.QueryBox(5, FBox::BuildAABB(firstSlowPosition, boxExtent), candidates);
+	TestEqual(TEXT("Bucket reusing the ring entry keeps none of the old margins"), candidates.Num(), 0);
+
+	candidates.Reset();
+	spatialIndex.QuerySegment(5, FVector(150.0f, -500.0f, 50.0f), FVector(150.0f, 500.0f, 50.0f), candidates);
+	TestTrue(TEXT("Segment finds the slow object after the ring wraps"), candidates.Contains(slowHandle));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,530 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineSpawnLog.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/MovementComponent.h"
+
+//Stop an actor from moving, colliding, expiring or being seen, so playback can pose it
+static void FreezeActor(AActor* actor)
+{
+	actor->SetActorHiddenInGame(true);
+	actor->SetActorEnableCollision(false);
+	actor->SetActorTickEnabled(false);
+	actor->SetLifeSpan(0.0f);
+
+	TInlineComponentArray<UMovementComponent*> movementComponents(actor);
+
+	for (UMovementComponent* movementComponent : movementComponents)
+	{
+		movementComponent->Deactivate();
+	}
+
+	if (UPrimitiveComponent* rootPrimitive = Cast<UPrimitiveComponent>(actor->GetRootComponent()))
+	{
+		rootPrimitive->SetSimulatePhysics(false);
+	}
+}
+
+//Let a frozen actor move again from a recorded state
+static void ThawActor(AActor* actor, const FVector& position, const FQuat& rotation, const FVector& velocity, bool simulatesPhysics, float lifeSpan)
+{
+	actor->SetActorLocationAndRotation(position, rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	actor->SetActorHiddenInGame(false);
+	actor->SetActorEnableCollision(true);
+	actor->SetActorTickEnabled(true);
+
+	TInlineComponentArray<UMovementComponent*> movementComponents(actor);
+
+	for (UMovementComponent* movementComponent : movementComponents)
+	{
+		//movement that stopped, such as a projectile coming to rest, lets go of its component
+		if (movementComponent->UpdatedComponent == nullptr)
+		{
+			movementComponent->SetUpdatedComponent(actor->GetRootComponent());
+		}
+
+		movementComponent->Activate(true);
+		movementComponent->Velocity = velocity;
+		movementComponent->UpdateComponentVelocity();
+	}
+
+	UPrimitiveComponent* rootPrimitive = Cast<UPrimitiveComponent>(actor->GetRootComponent());
+
+	if (simulatesPhysics && rootPrimitive != nullptr)
+	{
+		rootPrimitive->SetSimulatePhysics(true);
+		rootPrimitive->SetPhysicsLinearVelocity(velocity);
+	}
+
+	if (lifeSpan > 0.0f)
+	{
+		actor->SetLifeSpan(lifeSpan);
+	}
+}
+
+//Check if the actor existed at an absolute tick
+bool FTimelineSpawnRecord::IsSpawnedAt(int64 tick) const
+{
+	return tick >= spawnTick && (despawnTick == INDEX_NONE || tick < despawnTick);
+}
+
+//Get a recorded sample, 0 being the one for firstSampleTick
+const FTimelineTransientSample& FTimelineSpawnRecord::GetSample(int32 sampleIndex) const
+{
+	int32 offsetIndex = firstSampleOffset + sampleIndex;
+
+	return samplePages[offsetIndex / SamplesPerPage][offsetIndex % SamplesPerPage];
+}
+
+//Read the actor's state at a playback time in absolute ticks, interpolating between recorded ticks
+void FTimelineSpawnRecord::Sample(double playbackTime, FVector& outPosition, FQuat& outRotation, FVector& outVelocity) const
+{
+	//destroyed before its first position was recorded
+	if (numSamples == 0)
+	{
+		outPosition = spawnTransform.GetLocation();
+		outRotation = spawnTransform.GetRotation();
+		outVelocity = spawnVelocity;
+		return;
+	}
+
+	double sampleTime = FMath::Clamp(playbackTime - double(firstSampleTick), 0.0, double(numSamples - 1));
+	int32 fromIndex = FMath::FloorToInt32(sampleTime);
+	int32 toIndex = FMath::Min(fromIndex + 1, numSamples - 1);
+	float alpha = float(sampleTime - fromIndex);
+
+	const FTimelineTransientSample& fromSample = GetSample(fromIndex);
+	const FTimelineTransientSample& toSample = GetSample(toIndex);
+
+	outPosition = FMath::Lerp(fromSample.position, toSample.position, double(alpha));
+	outRotation = FQuat(FQuat4f::Slerp(fromSample.rotation, toSample.rotation, alpha));
+	outVelocity = FMath::Lerp(fromSample.velocity, toSample.velocity, double(alpha));
+}
+
+//Take the pages samples are stored in from an arena that outlives the log
+void FTimelineSpawnLog::Init(FTimelineArena* newArena)
+{
+	arena = newArena;
+}
+
+//Start recording an actor that just spawned, first recorded at an absolute tick
+void FTimelineSpawnLog::AddSpawn(AActor* actor, int64 tick)
+{
+	if (actor == nullptr || FindRecord(actor) != INDEX_NONE)
+	{
+		return;
+	}
+
+	FTimelineSpawnRecord& newRecord = records.AddDefaulted_GetRef();
+	newRecord.actorClass = actor->GetClass();
+	newRecord.spawnTick = tick;
+	newRecord.spawnTransform = actor->GetActorTransform();
+	newRecord.spawnVelocity = actor->GetVelocity();
+	newRecord.initialLifeSpan = actor->InitialLifeSpan;
+	newRecord.liveActor = actor;
+
+	if (UPrimitiveComponent* rootPrimitive = Cast<UPrimitiveComponent>(actor->GetRootComponent()))
+	{
+		newRecord.rootSimulatesPhysics = rootPrimitive->IsSimulatingPhysics();
+	}
+}
+
+//Mark an actor as destroyed before an absolute tick
+void FTimelineSpawnLog::MarkDespawn(AActor* actor, int64 tick)
+{
+	int32 recordIndex = FindRecord(actor);
+
+	if (recordIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FTimelineSpawnRecord& record = records[recordIndex];
+	record.liveActor = nullptr;
+
+	//playback does not change history, a stand-in shows the actor from here on and resuming spawns it again if needed
+	if (!isInPlayback)
+	{
+		record.despawnTick = tick;
+	}
+}
+
+//Record every live actor at an absolute tick
+void FTimelineSpawnLog::Capture(int64 tick)
+{
+	for (FTimelineSpawnRecord& record : records)
+	{
+		if (record.despawnTick != INDEX_NONE)
+		{
+			continue;
+		}
+
+		AActor* liveActor = record.liveActor.Get();
+
+		//actors removed without being destroyed, such as by level streaming, end here
+		if (liveActor == nullptr)
+		{
+			record.despawnTick = tick;
+			continue;
+		}
+
+		if (record.numSamples == 0)
+		{
+			record.firstSampleTick = tick;
+		}
+
+		FTimelineTransientSample& newSample = AddSample(record);
+		newSample.position = liveActor->GetActorLocation();
+		newSample.rotation = FQuat4f(liveActor->GetActorQuat());
+		newSample.velocity = liveActor->GetVelocity();
+	}
+}
+
+//Drop records destroyed before an absolute tick and samples recorded before it
+void FTimelineSpawnLog::PruneBefore(int64 tick)
+{
+	for (int32 recordIndex = records.Num() - 1; recordIndex >= 0; recordIndex--)
+	{
+		FTimelineSpawnRecord& record = records[recordIndex];
+
+		if (record.despawnTick != INDEX_NONE && record.despawnTick <= tick)
+		{
+			RemoveRecord(recordIndex);
+			continue;
+		}
+
+		//long lived actors keep only the samples still in the window, always keeping the latest
+		int32 numExpired = int32(FMath::Clamp(tick - record.firstSampleTick, int64(0), int64(FMath::Max(record.numSamples - 1, 0))));
+
+		if (numExpired > 0)
+		{
+			RemoveFirstSamples(record, numExpired);
+			record.firstSampleTick += numExpired;
+		}
+	}
+}
+
+//Freeze and hide every live actor to start playback
+void FTimelineSpawnLog::StartPlayback()
+{
+	isInPlayback = true;
+
+	for (FTimelineSpawnRecord& record : records)
+	{
+		if (AActor* liveActor = record.liveActor.Get())
+		{
+			FreezeActor(liveActor);
+		}
+	}
+}
+
+//Show every actor that existed at a playback time in absolute ticks and hide the rest
+void FTimelineSpawnLog::ApplyPlayback(UWorld* world, double playbackTime, int64 playbackTick)
+{
+	for (FTimelineSpawnRecord& record : records)
+	{
+		bool isShown = record.IsSpawnedAt(playbackTick);
+
+		//live actors are posed in place, destroyed ones borrow a stand-in only while they are shown
+		AActor* displayActor = record.liveActor.Get();
+
+		if (displayActor == nullptr)
+		{
+			if (!isShown)
+			{
+				ReleaseProxy(record);
+				continue;
+			}
+
+			if (!record.proxyActor.IsValid())
+			{
+				record.proxyActor = AcquireProxy(world, record.actorClass, record.spawnTransform);
+			}
+
+			displayActor = record.proxyActor.Get();
+		}
+
+		if (displayActor == nullptr)
+		{
+			continue;
+		}
+
+		if (isShown)
+		{
+			FVector position;
+			FQuat rotation;
+			FVector velocity;
+			record.Sample(playbackTime, position, rotation, velocity);
+
+			displayActor->SetActorLocationAndRotation(position, rotation, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+
+		displayActor->SetActorHiddenInGame(!isShown);
+	}
+}
+
+//Resume gameplay at an absolute tick, dropping actors spawned after it and bringing back the ones that existed at it
+void FTimelineSpawnLog::Resume(UWorld* world, int64 tick, float tickSeconds, TArray<AActor*>& outRespawnedActors)
+{
+	isInPlayback = false;
+
+	//actors spawned in the abandoned future are destroyed once their records are gone, so they are not marked as despawned
+	TArray<AActor*> abandonedActors;
+
+	for (int32 recordIndex = records.Num() - 1; recordIndex >= 0; recordIndex--)
+	{
+		FTimelineSpawnRecord& record = records[recordIndex];
+
+		//stand-ins are only for playback
+		ReleaseProxy(record);
+
+		if (record.spawnTick >= tick)
+		{
+			if (AActor* liveActor = record.liveActor.Get())
+			{
+				abandonedActors.Add(liveActor);
+			}
+
+			RemoveRecord(recordIndex);
+			continue;
+		}
+
+		//actors destroyed before the resume tick stay in history
+		if (!record.IsSpawnedAt(tick))
+		{
+			continue;
+		}
+
+		FVector position;
+		FQuat rotation;
+		FVector velocity;
+		record.Sample(double(tick), position, rotation, velocity);
+
+		//actors destroyed after the resume tick are spawned again, once per resume rather than on every scrub
+		AActor* liveActor = record.liveActor.Get();
+
+		if (liveActor == nullptr && record.actorClass != nullptr)
+		{
+			liveActor = SpawnLogActor(world, record.actorClass, FTransform(rotation, position));
+
+			if (liveActor != nullptr)
+			{
+				FreezeActor(liveActor);
+				record.liveActor = liveActor;
+				outRespawnedActors.Add(liveActor);
+			}
+		}
+
+		if (liveActor != nullptr)
+		{
+			//the actor lives for whatever it had left at the resume tick
+			float lifeSpan = record.initialLifeSpan > 0.0f ? FMath::Max(record.initialLifeSpan - float(tick - record.spawnTick) * tickSeconds, KINDA_SMALL_NUMBER) : 0.0f;
+
+			ThawActor(liveActor, position, rotation, velocity, record.rootSimulatesPhysics, lifeSpan);
+		}
+
+		//the actor is alive again and records from the resume tick on
+		record.despawnTick = INDEX_NONE;
+
+		if (record.numSamples > 0)
+		{
+			TruncateSamples(record, int32(FMath::Clamp(tick - record.firstSampleTick, int64(0), int64(record.numSamples))));
+		}
+	}
+
+	for (AActor* abandonedActor : abandonedActors)
+	{
+		abandonedActor->Destroy();
+	}
+}
+
+//Drop every record and destroy every stand-in
+void FTimelineSpawnLog::Reset()
+{
+	for (FTimelineSpawnRecord& record : records)
+	{
+		ReleaseProxy(record);
+		TruncateSamples(record, 0);
+	}
+
+	records.Reset();
+
+	//the pool would otherwise keep its hidden actors in the world for as long as the world lasts
+	DestroyProxies();
+}
+
+//Check if the log is spawning actors of its own
+bool FTimelineSpawnLog::IsSpawningActors() const
+{
+	return isSpawning;
+}
+
+//Number of records in the log
+int32 FTimelineSpawnLog::Num() const
+{
+	return records.Num();
+}
+
+//Find the record of a live actor
+int32 FTimelineSpawnLog::FindRecord(const AActor* actor) const
+{
+	return records.IndexOfByPredicate([actor](const FTimelineSpawnRecord& record)
+	{
+		return record.liveActor.Get() == actor;
+	});
+}
+
+//Take a stand-in for a class from the pool, spawning one if the pool is empty
+AActor* FTimelineSpawnLog::AcquireProxy(UWorld* world, UClass* actorClass, const FTransform& transform)
+{
+	if (actorClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	TArray<TWeakObjectPtr<AActor>>& classProxies = freeProxies.FindOrAdd(actorClass);
+
+	while (classProxies.Num() > 0)
+	{
+		AActor* proxyActor = classProxies.Pop(false).Get();
+
+		if (proxyActor != nullptr)
+		{
+			return proxyActor;
+		}
+	}
+
+	//the pool only grows to the most actors of a class shown at once, after that scrubbing reuses them
+	AActor* proxyActor = SpawnLogActor(world, actorClass, transform);
+
+	if (proxyActor != nullptr)
+	{
+		FreezeActor(proxyActor);
+	}
+
+	return proxyActor;
+}
+
+//Hide a record's stand-in and return it to the pool
+void FTimelineSpawnLog::ReleaseProxy(FTimelineSpawnRecord& record)
+{
+	AActor* proxyActor = record.proxyActor.Get();
+	record.proxyActor = nullptr;
+
+	if (proxyActor == nullptr)
+	{
+		return;
+	}
+
+	proxyActor->SetActorHiddenInGame(true);
+	freeProxies.FindOrAdd(proxyActor->GetClass()).Add(proxyActor);
+}
+
+//Destroy every stand-in in the pool
+void FTimelineSpawnLog::DestroyProxies()
+{
+	for (TPair<UClass*, TArray<TWeakObjectPtr<AActor>>>& classProxies : freeProxies)
+	{
+		for (const TWeakObjectPtr<AActor>& proxy : classProxies.Value)
+		{
+			if (AActor* proxyActor = proxy.Get())
+			{
+				proxyActor->Destroy();
+			}
+		}
+	}
+
+	freeProxies.Reset();
+}
+
+//Add a sample after a record's last one, taking a page when the last one is full
+FTimelineTransientSample& FTimelineSpawnLog::AddSample(FTimelineSpawnRecord& record)
+{
+	int32 offsetIndex = record.firstSampleOffset + record.numSamples;
+
+	if (offsetIndex == record.samplePages.Num() * FTimelineSpawnRecord::SamplesPerPage)
+	{
+		record.samplePages.Add(reinterpret_cast<FTimelineTransientSample*>(arena->AllocatePage()));
+	}
+
+	record.numSamples++;
+
+	FTimelineTransientSample& newSample = record.samplePages[offsetIndex / FTimelineSpawnRecord::SamplesPerPage][offsetIndex % FTimelineSpawnRecord::SamplesPerPage];
+	newSample = FTimelineTransientSample();
+
+	return newSample;
+}
+
+//Drop a record's oldest samples, returning pages that no longer hold any
+void FTimelineSpawnLog::RemoveFirstSamples(FTimelineSpawnRecord& record, int32 numRemoved)
+{
+	numRemoved = FMath::Clamp(numRemoved, 0, record.numSamples);
+	record.firstSampleOffset += numRemoved;
+	record.numSamples -= numRemoved;
+
+	int32 numExpiredPages = record.firstSampleOffset / FTimelineSpawnRecord::SamplesPerPage;
+
+	for (int32 pageIndex = 0; pageIndex < numExpiredPages; pageIndex++)
+	{
+		arena->FreePage(reinterpret_cast<uint8*>(record.samplePages[pageIndex]));
+	}
+
+	record.samplePages.RemoveAt(0, numExpiredPages, false);
+	record.firstSampleOffset -= numExpiredPages * FTimelineSpawnRecord::SamplesPerPage;
+}
+
+//Keep only a record's oldest samples, returning pages that no longer hold any
+void FTimelineSpawnLog::TruncateSamples(FTimelineSpawnRecord& record, int32 numKept)
+{
+	record.numSamples = FMath::Clamp(numKept, 0, record.numSamples);
+
+	//an empty record starts again at the beginning of its first page
+	if (record.numSamples == 0)
+	{
+		record.firstSampleOffset = 0;
+	}
+
+	int32 numUsedPages = record.numSamples > 0 ? FMath::DivideAndRoundUp(record.firstSampleOffset + record.numSamples, FTimelineSpawnRecord::SamplesPerPage) : 0;
+
+	for (int32 pageIndex = numUsedPages; pageIndex < record.samplePages.Num(); pageIndex++)
+	{
+		arena->FreePage(reinterpret_cast<uint8*>(record.samplePages[pageIndex]));
+	}
+
+	record.samplePages.SetNum(numUsedPages, false);
+}
+
+//Remove a record, returning its pages and stand-in
+void FTimelineSpawnLog::RemoveRecord(int32 recordIndex)
+{
+	FTimelineSpawnRecord& record = records[recordIndex];
+	ReleaseProxy(record);
+	TruncateSamples(record, 0);
+
+	records.RemoveAtSwap(recordIndex, 1, false);
+}
+
+//Spawn an actor owned by the log
+AActor* FTimelineSpawnLog::SpawnLogActor(UWorld* world, UClass* actorClass, const FTransform& transform)
+{
+	if (world == nullptr)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters spawnParams;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	isSpawning = true;
+	AActor* newActor = world->SpawnActor<AActor>(actorClass, transform, spawnParams);
+	isSpawning = false;
+
+	return newActor;
+}
@@ -0,0 +1,160 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "TimelineArena.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * Recorded state of a transient actor at one tick
+ */
+struct TIMEREWIND_API FTimelineTransientSample
+{
+	FVector position = FVector::ZeroVector;
+	FQuat4f rotation = FQuat4f::Identity;
+	FVector velocity = FVector::ZeroVector;
+};
+
+/**
+ * Lifetime of one transient actor, such as a projectile, from the tick it spawned to the tick it was destroyed
+ */
+struct TIMEREWIND_API FTimelineSpawnRecord
+{
+	//class the actor was spawned as, used to spawn stand-ins for it
+	TSubclassOf<AActor> actorClass;
+
+	//absolute tick the actor spawned at and was destroyed at, INDEX_NONE while it is still alive
+	int64 spawnTick = INDEX_NONE;
+	int64 despawnTick = INDEX_NONE;
+
+	//state the actor spawned with, used until its first position is recorded
+	FTransform spawnTransform;
+	FVector spawnVelocity = FVector::ZeroVector;
+
+	//life span the actor spawned with, 0 if it lives until something destroys it
+	float initialLifeSpan = 0.0f;
+
+	//was the actor's root simulating physics when it spawned
+	bool rootSimulatesPhysics = false;
+
+	//samples stored in each arena page
+	static constexpr int32 SamplesPerPage = FTimelineArena::PageSize / sizeof(FTimelineTransientSample);
+
+	//arena pages holding one sample per recorded tick, the first for firstSampleTick
+	//samples before firstSampleOffset in the first page have expired
+	TArray<FTimelineTransientSample*> samplePages;
+	int32 firstSampleOffset = 0;
+	int32 numSamples = 0;
+	int64 firstSampleTick = INDEX_NONE;
+
+	//the gameplay actor while it exists
+	TWeakObjectPtr<AActor> liveActor;
+
+	//pooled stand-in shown during playback once the gameplay actor is destroyed
+	TWeakObjectPtr<AActor> proxyActor;
+
+	//Check if the actor existed at an absolute tick
+	bool IsSpawnedAt(int64 tick) const;
+
+	//Get a recorded sample, 0 being the one for firstSampleTick
+	const FTimelineTransientSample& GetSample(int32 sampleIndex) const;
+
+	//Read the actor's state at a playback time in absolute ticks, interpolating between recorded ticks
+	void Sample(double playbackTime, FVector& outPosition, FQuat& outRotation, FVector& outVelocity) const;
+};
+
+/**
+ * Log of transient actors spawned and destroyed while recording, with a pool of stand-ins to show them in playback.
+ * Playback never spawns or destroys actors while scrubbing. Actors still alive are frozen and hidden in place,
+ * destroyed ones are shown by hidden stand-ins taken from a pool per class and returned to it once their record leaves the playback position.
+ */
+class TIMEREWIND_API FTimelineSpawnLog
+{
+public:
+	//Take the pages samples are stored in from an arena that outlives the log
+	void Init(FTimelineArena* newArena);
+
+	//Start recording an actor that just spawned, first recorded at an absolute tick
+	void AddSpawn(AActor* actor, int64 tick);
+
+	//Mark an actor as destroyed before an absolute tick. In playback the record only loses its actor
+	void MarkDespawn(AActor* actor, int64 tick);
+
+	//Record every live actor at an absolute tick
+	void Capture(int64 tick);
+
+	//Drop records destroyed before an absolute tick and samples recorded before it
+	void PruneBefore(int64 tick);
+
+	//Freeze and hide every live actor to start playback
+	void StartPlayback();
+
+	//Show every actor that existed at a playback time in absolute ticks and hide the rest
+	void ApplyPlayback(UWorld* world, double playbackTime, int64 playbackTick);
+
+	//Resume gameplay at an absolute tick, dropping actors spawned after it and bringing back the ones that existed at it
+	//Actors spawned again to replace destroyed ones are added to outRespawnedActors so they can be tracked
+	void Resume(UWorld* world, int64 tick, float tickSeconds, TArray<AActor*>& outRespawnedActors);
+
+	//Drop every record and destroy every stand-in. Live actors are left alone
+	//Must be called before the arena is reset, since the records return their pages to it
+	void Reset();
+
+	//Check if the log is spawning actors of its own, which should not be recorded as new spawns
+	bool IsSpawningActors() const;
+
+	//Number of records in the log
+	int32 Num() const;
+
+private:
+	//arena sample pages are taken from
+	FTimelineArena* arena = nullptr;
+
+	//every transient actor in the recorded window
+	TArray<FTimelineSpawnRecord> records;
+
+	//hidden stand-ins ready to be shown, per class
+	TMap<UClass*, TArray<TWeakObjectPtr<AActor>>> freeProxies;
+
+	//is the log in playback
+	bool isInPlayback = false;
+
+	//is the log spawning an actor
+	bool isSpawning = false;
+
+	//Find the record of a live actor. Returns INDEX_NONE if the actor is not recorded
+	int32 FindRecord(const AActor* actor) const;
+
+	//Take a stand-in for a class from the pool, spawning one if the pool is empty
+	AActor* AcquireProxy(UWorld* world, UClass* actorClass, const FTransform& transform);
+
+	//Hide a record's stand-in and return it to the pool
+	void ReleaseProxy(FTimelineSpawnRecord& record);
+
+	//Destroy every stand-in in the pool
+	void DestroyProxies();
+
+	//Add a sample after a record's last one, taking a page when the last one is full
+	FTimelineTransientSample& AddSample(FTimelineSpawnRecord& record);
+
+	//Drop a record's oldest samples, returning pages that no longer hold any
+	void RemoveFirstSamples(FTimelineSpawnRecord& record, int32 numRemoved);
+
+	//Keep only a record's oldest samples, returning pages that no longer hold any
+	void TruncateSamples(FTimelineSpawnRecord& record, int32 numKept);
+
+	//Remove a record, returning its pages and stand-in
+	void RemoveRecord(int32 recordIndex);
+
+	//Spawn an actor owned by the log
+	AActor* SpawnLogActor(UWorld* world, UClass* actorClass, const FTransform& transform);
+};
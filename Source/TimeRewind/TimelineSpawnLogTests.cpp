@@ -0,0 +1,96 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineSpawnLog.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimelineSpawnLogResumeTest, "TimeRewind.SpawnLog.Resume", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+//Record actors spawning and being destroyed, resume partway through and prune, checking records and sample pages are dropped with them
+bool FTimelineSpawnLogResumeTest::RunTest(const FString& Parameters)
+{
+	FTimelineArena arena;
+	arena.Init(FTimelineArena::PageSize * 32);
+
+	FTimelineSpawnLog spawnLog;
+	spawnLog.Init(&arena);
+
+	//one actor destroyed before the resume tick, one destroyed after it and one spawned after it
+	AActor* earlyActor = NewObject<AActor>(GetTransientPackage());
+	AActor* spanningActor = NewObject<AActor>(GetTransientPackage());
+	AActor* lateActor = NewObject<AActor>(GetTransientPackage());
+
+	for (int64 tick = 0; tick < 200; tick++)
+	{
+		if (tick == 0)
+		{
+			spawnLog.AddSpawn(earlyActor, tick);
+		}
+		else if (tick == 10)
+		{
+			spawnLog.AddSpawn(spanningActor, tick);
+		}
+		else if (tick == 120)
+		{
+			spawnLog.AddSpawn(lateActor, tick);
+		}
+		else if (tick == 50)
+		{
+			spawnLog.MarkDespawn(earlyActor, tick);
+		}
+		else if (tick == 150)
+		{
+			spawnLog.MarkDespawn(spanningActor, tick);
+		}
+		else if (tick == 180)
+		{
+			spawnLog.MarkDespawn(lateActor, tick);
+		}
+
+		spawnLog.Capture(tick);
+	}
+
+	//bytes of the pages holding a run of samples, counted from the first sample of a record's first page
+	auto GetSampleBytes = [](int32 firstSample, int32 numSamples)
+	{
+		const int32 samplesPerPage = FTimelineSpawnRecord::SamplesPerPage;
+		return int64(FMath::DivideAndRoundUp(firstSample + numSamples, samplesPerPage) - firstSample / samplesPerPage) * FTimelineArena::PageSize;
+	};
+
+	TestEqual(TEXT("Every actor is recorded"), spawnLog.Num(), 3);
+	TestEqual(TEXT("Samples are stored in arena pages"), arena.GetUsedBytes(), GetSampleBytes(0, 50) + GetSampleBytes(0, 140) + GetSampleBytes(0, 60));
+
+	//no actor is alive at the end, so resuming without a world neither destroys nor spawns any
+	TArray<AActor*> respawnedActors;
+	spawnLog.Resume(nullptr, 100, 0.06f, respawnedActors);
+
+	TestEqual(TEXT("Actors spawned after the resume tick are dropped"), spawnLog.Num(), 2);
+	TestEqual(TEXT("Nothing is spawned without a world"), respawnedActors.Num(), 0);
+	TestEqual(TEXT("Samples after the resume tick are returned"), arena.GetUsedBytes(), GetSampleBytes(0, 50) + GetSampleBytes(0, 90));
+
+	//pruning drops destroyed actors and expired samples, returning a page once none of its samples are left
+	spawnLog.PruneBefore(60);
+
+	TestEqual(TEXT("Actors destroyed before the window are dropped"), spawnLog.Num(), 1);
+	TestEqual(TEXT("Samples still in the window are kept"), arena.GetUsedBytes(), GetSampleBytes(50, 40));
+
+	spawnLog.PruneBefore(80);
+	TestEqual(TEXT("Expired pages are returned"), arena.GetUsedBytes(), GetSampleBytes(70, 20));
+
+	spawnLog.Reset();
+
+	TestEqual(TEXT("No records after reset"), spawnLog.Num(), 0);
+	TestEqual(TEXT("Every page is returned by reset"), arena.GetUsedBytes(), int64(0));
+
+	return true;
+}
+
+#endif
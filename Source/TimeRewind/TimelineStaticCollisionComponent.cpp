@@ -0,0 +1,141 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "TimelineStaticCollisionComponent.h"
+
+//distance between traces across a surface, the quad size of a landscape at its default scale
+static const float SurfaceTraceSpacing = 100.0f;
+//most traces along each side of a surface, so very large surfaces are traced more coarsely instead of for longer
+static const int32 MaxSurfaceTracesPerSide = 512;
+
+//Copy a component's collision, returning the transform the copy is placed at
+FTransform UTimelineStaticCollisionComponent::CopyCollision(UPrimitiveComponent* sourceComponent)
+{
+	SetMobility(EComponentMobility::Static);
+	BodyInstance.CopyBodyInstancePropertiesFrom(&sourceComponent->BodyInstance);
+	SetVisibility(false);
+
+	//sharing the body setup keeps every shape the component collides with, whatever its kind
+	collisionBodySetup = sourceComponent->GetBodySetup();
+
+	if (collisionBodySetup != nullptr)
+	{
+		return sourceComponent->GetComponentTransform();
+	}
+
+	TraceSurface(sourceComponent);
+
+	//the traced surface is already in world space
+	return FTransform::Identity;
+}
+
+//Body setup shared with the copied component, or built from the traced surface
+UBodySetup* UTimelineStaticCollisionComponent::GetBodySetup()
+{
+	return collisionBodySetup;
+}
+
+//Hand the traced surface to the body setup when it cooks its triangle mesh
+bool UTimelineStaticCollisionComponent::GetPhysicsTriMeshData(FTriMeshCollisionData* collisionData, bool inUseAllTriData)
+{
+	if (surfaceTriangles.Num() == 0)
+	{
+		return false;
+	}
+
+	collisionData->Vertices = surfaceVertices;
+	collisionData->Indices = surfaceTriangles;
+	collisionData->bFlipNormals = true;
+
+	return true;
+}
+
+bool UTimelineStaticCollisionComponent::ContainsPhysicsTriMeshData(bool inUseAllTriData) const
+{
+	return surfaceTriangles.Num() > 0;
+}
+
+bool UTimelineStaticCollisionComponent::WantsNegXTriMesh()
+{
+	return false;
+}
+
+//Trace a component's surface from above on a grid and build a body setup from it
+void UTimelineStaticCollisionComponent::TraceSurface(UPrimitiveComponent* sourceComponent)
+{
+	surfaceVertices.Reset();
+	surfaceTriangles.Reset();
+
+	FBox bounds = sourceComponent->Bounds.GetBox();
+	FVector size = bounds.GetSize();
+	int32 numX = FMath::Clamp(FMath::CeilToInt(float(size.X) / SurfaceTraceSpacing), 1, MaxSurfaceTracesPerSide) + 1;
+	int32 numY = FMath::Clamp(FMath::CeilToInt(float(size.Y) / SurfaceTraceSpacing), 1, MaxSurfaceTracesPerSide) + 1;
+
+	//only the copied component is traced, against the same collision the recorded world uses
+	FCollisionQueryParams traceParams(SCENE_QUERY_STAT(TimelineSurfaceTrace), true);
+
+	//vertex traced at each grid point, INDEX_NONE where the trace missed such as landscape holes
+	TArray<int32> gridVertices;
+	gridVertices.SetNumUninitialized(numX * numY);
+
+	for (int32 y = 0; y < numY; y++)
+	{
+		for (int32 x = 0; x < numX; x++)
+		{
+			double traceX = FMath::Lerp(bounds.Min.X, bounds.Max.X, double(x) / double(numX - 1));
+			double traceY = FMath::Lerp(bounds.Min.Y, bounds.Max.Y, double(y) / double(numY - 1));
+			FHitResult hit;
+
+			bool isHit = sourceComponent->LineTraceComponent(hit, FVector(traceX, traceY, bounds.Max.Z + 1.0), FVector(traceX, traceY, bounds.Min.Z - 1.0), traceParams);
+			gridVertices[x + y * numX] = isHit ? surfaceVertices.Add(FVector3f(hit.ImpactPoint)) : INDEX_NONE;
+		}
+	}
+
+	//two triangles for every grid square traced at all four corners, wound like landscape collision
+	for (int32 y = 0; y < numY - 1; y++)
+	{
+		for (int32 x = 0; x < numX - 1; x++)
+		{
+			int32 vertex00 = gridVertices[x + y * numX];
+			int32 vertex10 = gridVertices[x + 1 + y * numX];
+			int32 vertex01 = gridVertices[x + (y + 1) * numX];
+			int32 vertex11 = gridVertices[x + 1 + (y + 1) * numX];
+
+			if (vertex00 == INDEX_NONE || vertex10 == INDEX_NONE || vertex01 == INDEX_NONE || vertex11 == INDEX_NONE)
+			{
+				continue;
+			}
+
+			FTriIndices& firstTriangle = surfaceTriangles.AddDefaulted_GetRef();
+			firstTriangle.v0 = vertex00;
+			firstTriangle.v1 = vertex11;
+			firstTriangle.v2 = vertex10;
+
+			FTriIndices& secondTriangle = surfaceTriangles.AddDefaulted_GetRef();
+			secondTriangle.v0 = vertex00;
+			secondTriangle.v1 = vertex01;
+			secondTriangle.v2 = vertex11;
+		}
+	}
+
+	if (surfaceTriangles.Num() == 0)
+	{
+		return;
+	}
+
+	//cook the surface at runtime as complex collision also used as simple collision, like other generated meshes
+	collisionBodySetup = NewObject<UBodySetup>(this, NAME_None, RF_Transient);
+	collisionBodySetup->BodySetupGuid = FGuid::NewGuid();
+	collisionBodySetup->bGenerateMirroredCollision = false;
+	collisionBodySetup->bDoubleSidedGeometry = true;
+	collisionBodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
+	collisionBodySetup->bHasCookedCollisionData = true;
+	collisionBodySetup->InvalidatePhysicsData();
+	collisionBodySetup->CreatePhysicsMeshes();
+}
@@ -0,0 +1,52 @@
+//Copyright 2023 Cody Van De Mark
+//
+//Permission is hereby granted, free of charge, to any person obtaining a copy of this softwareand associated documentation files(the Software), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and /or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+//
+//The above copyright noticeand this permission notice shall be included in all copies or substantial portions of the Software.
+//
+//THE SOFTWARE IS PROVIDED AS IS, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "Interfaces/Interface_CollisionDataProvider.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "TimelineStaticCollisionComponent.generated.h"
+
+/**
+ * Copy of a static component's collision in the resimulation world.
+ * Components with a body setup, such as static meshes, brushes and shapes, share it, so simple shapes, convex hulls
+ * and complex triangle meshes all keep the geometry the recorded world already cooked.
+ * Components whose collision is not in a body setup, such as landscape heightfields, are traced from above in the
+ * recorded world and rebuilt as a triangle mesh of the surface.
+ */
+UCLASS(Transient)
+class TIMEREWIND_API UTimelineStaticCollisionComponent : public UPrimitiveComponent, public IInterface_CollisionDataProvider
+{
+	GENERATED_BODY()
+
+public:
+	//Copy a component's collision, returning the transform the copy is placed at. Call before the copy is registered
+	FTransform CopyCollision(UPrimitiveComponent* sourceComponent);
+
+	//Body setup shared with the copied component, or built from the traced surface
+	virtual UBodySetup* GetBodySetup() override;
+
+	//Hand the traced surface to the body setup when it cooks its triangle mesh
+	virtual bool GetPhysicsTriMeshData(FTriMeshCollisionData* collisionData, bool inUseAllTriData) override;
+	virtual bool ContainsPhysicsTriMeshData(bool inUseAllTriData) const override;
+	virtual bool WantsNegXTriMesh() override;
+
+private:
+	//body setup of the copied component, or the one built from its traced surface
+	UPROPERTY()
+	UBodySetup* collisionBodySetup;
+
+	//world space vertices and triangles of the traced surface, empty when the body setup is shared
+	TArray<FVector3f> surfaceVertices;
+	TArray<FTriIndices> surfaceTriangles;
+
+	//Trace a component's surface from above on a grid and build a body setup from it
+	void TraceSurface(UPrimitiveComponent* sourceComponent);
+};